@@ -48,20 +48,21 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include "general.h"
 #include "board_service.h"
 #include "sixstep_control.h"
+#include "scheduler.h"
 
 // <editor-fold defaultstate="collapsed" desc="Global Variables  ">
-/* Pointers to PWM states for inverter switching arrays */
-uint16_t *PWM1_STATE;
-uint16_t *PWM2_STATE;
-uint16_t *PWM3_STATE;
+/* Pointer to packed PWM3, PWM2 and PWM1 states of the inverter switching 
+   array */
+const uint16_t *PWM_STATE;
 
 // </editor-fold>
 
 // <editor-fold defaultstate="collapsed" desc="STATIC FUNCTIONS ">
 static void MCAPP_GetControlInputs(MCAPP_BLDC_SIXSTEP_CONTROL_T *);
-static void MCAPP_PWM_Override (uint16_t );
+inline static void MCAPP_PWM_Override (uint16_t );
 
 // </editor-fold>
 
@@ -95,6 +96,13 @@ void MCAPP_SixStepControlInit(MCAPP_BLDC_SIXSTEP_CONTROL_T *pSixStepControl)
     pSixStepControl->measuredSpeed              = 0;
     pSixStepControl->pwmDuty                    = 0;
     pSixStepControl->sector                     = 0;
+    pSixStepControl->speedLoopCount             = 0;
+    pSixStepControl->speedSampleCount           = *(pSixStepControl->pSpeedSampleCount);
+    
+    MCAPP_SchedulerTaskInit(&pSixStepControl->controlInputTask,
+                    CONTROL_INPUT_TASK_DIVISOR, CONTROL_INPUT_TASK_PHASE);
+    MCAPP_SchedulerTaskInit(&pSixStepControl->speedLoopTask,
+                    SPEED_LOOP_TASK_DIVISOR, SPEED_LOOP_TASK_PHASE);
 
     pSixStepControl->ctrlParam.targetCurrent    = 0;
     pSixStepControl->ctrlParam.targetDuty       = 0;
@@ -107,7 +115,8 @@ void MCAPP_SixStepControlInit(MCAPP_BLDC_SIXSTEP_CONTROL_T *pSixStepControl)
 /**
 * <B> Function: void MCAPP_GetControlInputs (MCAPP_BLDC_SIXSTEP_CONTROL_T *) </B>
 *
-* @brief Function read motor control inputs.
+* @brief Function read motor control inputs. Scaling of the control input
+*        to speed and current references is decimated by controlInputTask.
 *
 * @param Pointer to the data structure containing Control parameters.
 * @return none.
@@ -133,22 +142,31 @@ static void MCAPP_GetControlInputs(MCAPP_BLDC_SIXSTEP_CONTROL_T *pControl)
         pControl->commutationSector = pControl->sector;
     }
     
-    if(pControl->ctrlParam.controlLoop == SPEED_CONTROL)
+    if(MCAPP_SchedulerTaskDue(&pControl->controlInputTask) == false)
+    {
+        /* References are held between control input task runs */
+    }
+    else if((pControl->ctrlParam.controlLoop == SPEED_CONTROL) ||
+            (pControl->ctrlParam.controlLoop == SPEED_CURRENT_CONTROL))
     {
         /* Speed Input from control input for speed control */
        pControl->ctrlParam.targetSpeed = (uint16_t)(pMotor->MinSpeed + 
-               ((__builtin_muluu(pMotor->MaxSpeed - pMotor->MinSpeed,
+               ((MCAPP_MulUU(pMotor->MaxSpeed - pMotor->MinSpeed,
                pControl->ctrlParam.controlInput)) >> 15));
     }
-    if(pControl->ctrlParam.controlLoop == CURRENT_CONTROL)
+    else if(pControl->ctrlParam.controlLoop == CURRENT_CONTROL)
     {
         /* Current Input from control input for current control */
         pControl->ctrlParam.targetCurrent = (int16_t)
-                ((__builtin_mulsu(pMotor->qRatedCurrent,
+                ((MCAPP_MulSU(pMotor->qRatedCurrent,
                 pControl->ctrlParam.controlInput)) >> 15);
+    } 
+    if((pControl->ctrlParam.controlLoop == CURRENT_CONTROL) ||
+            (pControl->ctrlParam.controlLoop == SPEED_CURRENT_CONTROL))
+    {
         /* Measured filtered bus current */
         pControl->avgCurrent = *(pControl->pAvgCurrent); 
-    } 
+    }
 }
 
 /**
@@ -166,6 +184,7 @@ static void MCAPP_GetControlInputs(MCAPP_BLDC_SIXSTEP_CONTROL_T *pControl)
 void MCAPP_SixStepControlStateMachine(MCAPP_BLDC_SIXSTEP_CONTROL_T *pControl)
 {    
     MCAPP_CONTROL_T *pCtrlParam = &pControl->ctrlParam;
+    int32_t ki;
     
     switch (pControl->controlState)
     {
@@ -184,6 +203,10 @@ void MCAPP_SixStepControlStateMachine(MCAPP_BLDC_SIXSTEP_CONTROL_T *pControl)
             {
                 pControl->controlState = SPEED_CONTROL_LOOP;
             }
+            else if( pCtrlParam->controlLoop == SPEED_CURRENT_CONTROL )
+            {
+                pControl->controlState = SPEED_CURRENT_CONTROL_LOOP;
+            }
             else
                 pControl->controlState = CONTROL_OPEN_LOOP;
             break;
@@ -191,7 +214,7 @@ void MCAPP_SixStepControlStateMachine(MCAPP_BLDC_SIXSTEP_CONTROL_T *pControl)
         case CONTROL_OPEN_LOOP:
             MCAPP_GetControlInputs(pControl);
             MCAPP_PWM_Override(pControl->commutationSector);
-            pControl->ctrlParam.targetDuty = (uint16_t)((__builtin_mulss(pControl->ctrlParam.controlInput,
+            pControl->ctrlParam.targetDuty = (uint16_t)((MCAPP_MulSS(pControl->ctrlParam.controlInput,
                                          pControl->pwmPeriod)>>15));
             pControl->pwmDuty = pControl->ctrlParam.targetDuty;
             
@@ -200,15 +223,18 @@ void MCAPP_SixStepControlStateMachine(MCAPP_BLDC_SIXSTEP_CONTROL_T *pControl)
         case SPEED_CONTROL_LOOP:
             MCAPP_GetControlInputs(pControl);
             MCAPP_PWM_Override(pControl->commutationSector);
-            /* PI control in Speed Loop */
-            pControl->piSpeedInput.inReference = pControl->ctrlParam.targetSpeed;
-            pControl->piSpeedInput.inMeasure   = pControl->measuredSpeed;
-            MC_ControllerPIUpdate_Assembly( pControl->piSpeedInput.inReference,
-                                            pControl->piSpeedInput.inMeasure,
-                                           &pControl->piSpeedInput.piState,
-                                           &pControl->piSpeedOutput.out);
+            /* PI control in Speed Loop, decimated by speedLoopTask */
+            if(MCAPP_SchedulerTaskDue(&pControl->speedLoopTask))
+            {
+                pControl->piSpeedInput.inReference = pControl->ctrlParam.targetSpeed;
+                pControl->piSpeedInput.inMeasure   = pControl->measuredSpeed;
+                MC_ControllerPIUpdate_Assembly( pControl->piSpeedInput.inReference,
+                                                pControl->piSpeedInput.inMeasure,
+                                               &pControl->piSpeedInput.piState,
+                                               &pControl->piSpeedOutput.out);
+            }
             pControl->pwmDuty = (uint16_t) 
-                    (__builtin_mulss(pControl->piSpeedOutput.out, 
+                    (MCAPP_MulSS(pControl->piSpeedOutput.out, 
                     pControl->pwmPeriod) >> 15);
           
             break;
@@ -225,7 +251,56 @@ void MCAPP_SixStepControlStateMachine(MCAPP_BLDC_SIXSTEP_CONTROL_T *pControl)
                                            &pControl->piCurrentInput.piState,
                                            &pControl->piCurrentOutput.out);
             pControl->pwmDuty = (uint16_t) 
-                    (__builtin_mulss(pControl->piCurrentOutput.out, 
+                    (MCAPP_MulSS(pControl->piCurrentOutput.out, 
+                    pControl->pwmPeriod) >> 15);
+            
+            break;
+
+        case SPEED_CURRENT_CONTROL_LOOP:
+            MCAPP_GetControlInputs(pControl);
+            MCAPP_PWM_Override(pControl->commutationSector);
+            
+            /* PI control in Speed Loop, executed on a new speed value only; 
+               output is the current reference */
+            pControl->speedLoopCount++;
+            if((*(pControl->pSpeedSampleCount) != pControl->speedSampleCount) ||
+                    (pControl->speedLoopCount >= SPEED_LOOP_MAX_INTERVAL))
+            {
+                pControl->speedSampleCount = *(pControl->pSpeedSampleCount);
+                /* Integral gain for the control periods elapsed since the 
+                   last execution */
+                ki = MCAPP_MulSS(pControl->speedLoopKi, 
+                                        (int16_t)pControl->speedLoopCount);
+                pControl->piSpeedInput.piState.ki = 
+                                (ki > INT16_MAX) ? INT16_MAX : (int16_t)ki;
+                pControl->speedLoopCount = 0;
+                
+                pControl->piSpeedInput.inReference = pCtrlParam->targetSpeed;
+                pControl->piSpeedInput.inMeasure   = pControl->measuredSpeed;
+                MC_ControllerPIUpdate_Assembly( pControl->piSpeedInput.inReference,
+                                                pControl->piSpeedInput.inMeasure,
+                                               &pControl->piSpeedInput.piState,
+                                               &pControl->piSpeedOutput.out);
+                /* Speed PI output is limited to a non negative current 
+                   reference, whatever SPDCURCNTR_OUTMIN */
+                if(pControl->piSpeedOutput.out < 0)
+                {
+                    pControl->piSpeedOutput.out = 0;
+                }
+                pCtrlParam->targetCurrent = (int16_t)
+                        ((MCAPP_MulSU(pControl->motor.qRatedCurrent,
+                        (uint16_t)pControl->piSpeedOutput.out)) >> 15);
+            }
+            
+            /* PI control in Current Loop, executed every control period */
+            pControl->piCurrentInput.inReference = pCtrlParam->targetCurrent;
+            pControl->piCurrentInput.inMeasure   = pControl->avgCurrent;
+            MC_ControllerPIUpdate_Assembly( pControl->piCurrentInput.inReference,
+                                            pControl->piCurrentInput.inMeasure,
+                                           &pControl->piCurrentInput.piState,
+                                           &pControl->piCurrentOutput.out);
+            pControl->pwmDuty = (uint16_t) 
+                    (MCAPP_MulSS(pControl->piCurrentOutput.out, 
                     pControl->pwmPeriod) >> 15);
             
             break;
@@ -244,7 +319,8 @@ void MCAPP_SixStepControlStateMachine(MCAPP_BLDC_SIXSTEP_CONTROL_T *pControl)
  /**
 * <B> Function: void MCAPP_PWM_Override (uint16_t )  </B>
 *
-* @brief Function to override PWM outputs.
+* @brief Function to override PWM outputs. All three generators are written
+*        from one packed table entry.
 *
 * @param Commutation sector.
 * @return none.
@@ -252,27 +328,111 @@ void MCAPP_SixStepControlStateMachine(MCAPP_BLDC_SIXSTEP_CONTROL_T *pControl)
 * <CODE> MCAPP_PWM_Override(sector); </CODE>
 *
 */
-static void MCAPP_PWM_Override(uint16_t sector)
+inline static void MCAPP_PWM_Override(uint16_t sector)
+{
+   HAL_MC1PWMOverrideCommit(PWM_STATE[sector]); 
+}
+
+/**
+* <B> Function: void MCAPP_SixStepEdgeCommutate (MCAPP_BLDC_SIXSTEP_CONTROL_T *, uint16_t)  </B>
+*
+* @brief Function to apply the commutation pattern of a new Hall value, 
+*        called from the Hall change notification interrupt. The CN and the
+*        control interrupt have the same priority and do not preempt each 
+*        other; the control interrupt commutates from the latest Hall value,
+*        hence it cannot apply a pattern older than the one applied here.
+*
+* @param Pointer to the data structure containing Control parameters.
+* @param Hall value.
+* @return none.
+* @example
+* <CODE> MCAPP_SixStepEdgeCommutate(&pControl, hallValue); </CODE>
+*
+*/
+void MCAPP_SixStepEdgeCommutate(MCAPP_BLDC_SIXSTEP_CONTROL_T *pControl,
+                                uint16_t hallValue)
+{
+    if(pControl->directionCmd == 1)
+    {
+        MCAPP_PWM_Override(7 - hallValue);
+    }
+    else
+    {
+        MCAPP_PWM_Override(hallValue);
+    }
+}
+
+/**
+* <B> Function: void MCAPP_SixStepControlPreload (MCAPP_BLDC_SIXSTEP_CONTROL_T *, uint16_t)  </B>
+*
+* @brief Function to start the control loops from a given duty cycle when a
+*        coasting motor is restarted. The controller that sets the duty cycle
+*        is preset to it and the commutation pattern of the present sector 
+*        is applied; call after the PWM outputs are enabled.
+*
+* @param Pointer to the data structure containing Control parameters.
+* @param Duty cycle (unit : PWM timer counts).
+* @return none.
+* @example
+* <CODE> MCAPP_SixStepControlPreload(&pControl, duty); </CODE>
+*
+*/
+void MCAPP_SixStepControlPreload(MCAPP_BLDC_SIXSTEP_CONTROL_T *pControl,
+                                 uint16_t duty)
 {
-   PWM3_OverrideEnableDataSet(PWM3_STATE[sector]); 
-   PWM2_OverrideEnableDataSet(PWM2_STATE[sector]); 
-   PWM1_OverrideEnableDataSet(PWM1_STATE[sector]); 
+    MCAPP_CONTROL_T *pCtrlParam = &pControl->ctrlParam;
+    int16_t out;
+    
+    if(duty >= pControl->pwmPeriod)
+    {
+        out = INT16_MAX;
+    }
+    else
+    {
+        out = (int16_t)MCAPP_DivUD((uint32_t)duty << 15, pControl->pwmPeriod);
+    }
+    
+    if(pCtrlParam->controlLoop == SPEED_CONTROL)
+    {
+        if(out > pControl->piSpeedInput.piState.outMax)
+        {
+            out = pControl->piSpeedInput.piState.outMax;
+        }
+        pControl->piSpeedOutput.out = out;
+        pControl->piSpeedInput.piState.integrator = (int32_t)out << 16;
+    }
+    else if((pCtrlParam->controlLoop == CURRENT_CONTROL) ||
+            (pCtrlParam->controlLoop == SPEED_CURRENT_CONTROL))
+    {
+        if(out > pControl->piCurrentInput.piState.outMax)
+        {
+            out = pControl->piCurrentInput.piState.outMax;
+        }
+        pControl->piCurrentOutput.out = out;
+        pControl->piCurrentInput.piState.integrator = (int32_t)out << 16;
+        /* Current reference from the speed controller starts from zero */
+        pControl->piSpeedOutput.out = 0;
+        pControl->piSpeedInput.piState.integrator = 0;
+    }
+    pControl->pwmDuty = (uint16_t)(MCAPP_MulSS(out, pControl->pwmPeriod) >> 15);
+    
+    MCAPP_GetControlInputs(pControl);
+    MCAPP_PWM_Override(pControl->commutationSector);
 }
 
 /**
-* <B> Function: void MCAPP_LoadInverterSwitchingArray (uint16_t * , uint16_t *, uint16_t *)  </B>
+* <B> Function: void MCAPP_LoadInverterSwitchingArray (const uint16_t *)  </B>
 *
-* @brief Function to load switching arrays for BLDC inverter control.
+* @brief Function to load switching array for BLDC inverter control.
 *
-* @param switching arrays for PWM1,PWM2, and PWM3.
+* @param switching array, PWM3, PWM2 and PWM1 states packed by 
+*        PWM_OVERRIDE_PACK.
 * @return none.
 * @example
-* <CODE> MCAPP_LoadInverterSwitchingArray(sector); </CODE>
+* <CODE> MCAPP_LoadInverterSwitchingArray(array); </CODE>
 *
 */
-void MCAPP_LoadInverterSwitchingArray(uint16_t *value3, uint16_t *value2, uint16_t *value1)
+void MCAPP_LoadInverterSwitchingArray(const uint16_t *value)
 {
-    PWM3_STATE = value3;
-    PWM2_STATE = value2;
-    PWM1_STATE = value1;
+    PWM_STATE = value;
 }
\ No newline at end of file
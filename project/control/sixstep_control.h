@@ -54,12 +54,31 @@ extern "C" {
 // <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
 
 #include "sixstep_types.h"
+#include "pwm.h"
   
 // </editor-fold>
 
 // <editor-fold defaultstate="collapsed" desc="DEFINITIONS ">  
 
 #define MCAPP_CONTROL_SCHEME_T              MCAPP_BLDC_SIXSTEP_CONTROL_T
+
+/* Rate of the decimated control tasks (unit : Hz) */
+#define CONTROL_INPUT_TASK_RATE_HZ          2000UL
+#define SPEED_LOOP_TASK_RATE_HZ             2000UL
+/* Divisor of the control interrupt rate and phase of the decimated tasks; 
+   tasks with equal divisors run in different interrupts */
+#define CONTROL_INPUT_TASK_DIVISOR          \
+                    (uint16_t)(PWMFREQUENCY_HZ/CONTROL_INPUT_TASK_RATE_HZ)
+#define CONTROL_INPUT_TASK_PHASE            0
+#define SPEED_LOOP_TASK_DIVISOR             \
+                    (uint16_t)(PWMFREQUENCY_HZ/SPEED_LOOP_TASK_RATE_HZ)
+#define SPEED_LOOP_TASK_PHASE               (SPEED_LOOP_TASK_DIVISOR/2)
+
+/* Speed and current control : the speed loop runs on every new speed value,
+   or after SPEED_LOOP_MAX_INTERVAL_SEC if no Hall edge occurs (low speed) */
+#define SPEED_LOOP_MAX_INTERVAL_SEC         0.001f
+#define SPEED_LOOP_MAX_INTERVAL             \
+                    (uint16_t)(SPEED_LOOP_MAX_INTERVAL_SEC/LOOPTIME_SEC)
        
 // </editor-fold>
     
@@ -67,7 +86,9 @@ extern "C" {
 
 void MCAPP_SixStepControlInit(MCAPP_CONTROL_SCHEME_T *);
 void MCAPP_SixStepControlStateMachine (MCAPP_CONTROL_SCHEME_T *);
-void MCAPP_LoadInverterSwitchingArray(uint16_t *,uint16_t *,uint16_t *);   
+void MCAPP_LoadInverterSwitchingArray(const uint16_t *);
+void MCAPP_SixStepEdgeCommutate(MCAPP_CONTROL_SCHEME_T *, uint16_t);
+void MCAPP_SixStepControlPreload(MCAPP_CONTROL_SCHEME_T *, uint16_t);   
 // </editor-fold>
 
 #ifdef	__cplusplus
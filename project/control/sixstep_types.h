@@ -59,6 +59,7 @@ extern "C" {
 #include "motor_types.h"
 #include "sixstep_control_types.h"
 #include "motor_control_declarations.h"
+#include "scheduler_types.h"
 // </editor-fold>
 
 // <editor-fold defaultstate="expanded" desc="ENUMERATED CONSTANTS ">
@@ -71,6 +72,8 @@ typedef enum
     SPEED_CONTROL_LOOP = 3,             /* Closed loop Current control */
     CURRENT_CONTROL_LOOP = 4,           /* Closed loop Speed control */
     CONTROL_FAULT = 5,                  /* Control state machine is in Fault */ 
+    SPEED_CURRENT_CONTROL_LOOP = 6,     /* Closed loop Speed control with 
+                                           inner Current control */
             
 }SIXSTEP_CONTROL_STATE_T;
 
@@ -79,6 +82,7 @@ typedef enum
     SPEED_CONTROL       = 1,       
     CURRENT_CONTROL     = 2,       
     OPEN_LOOP           = 3,       
+    SPEED_CURRENT_CONTROL = 4,       
             
 }MCAPP_CRTL_LOOP_T;
 // </editor-fold>
@@ -91,6 +95,7 @@ typedef struct
         *pSector,           /* Pointer for Hall sector */
         *pMeasuredSpeed,    /* Pointer for Speed */
         *pDirectionCmd,     /* Pointer for direction command */
+        *pSpeedSampleCount, /* Pointer for speed sample counter */
         sector,             /* Variable for Hall sector value */
         commutationSector,  /* Variable for sector to commutate */
         measuredSpeed,      /* Variable for speed */
@@ -98,11 +103,14 @@ typedef struct
         faultStatus,        /* Variable for Fault Status */
         pwmPeriod,          /* Variable for PWM period */
         pwmDuty,            /* Variable for PWM duty */
+        speedSampleCount,   /* Speed sample used by the last speed loop run */
+        speedLoopCount,     /* Control periods since the last speed loop run */
         controlState;       /* State variable for control state machine */;
     
     int16_t
         *pAvgCurrent,       /* Pointer for average current */
-        avgCurrent;         /* Variable for average current */
+        avgCurrent,         /* Variable for average current */
+        speedLoopKi;        /* Speed PI integral gain per control period */
     
     MCAPP_MOTOR_T  motor;   /* Motor parameters */
     
@@ -117,6 +125,10 @@ typedef struct
     MCAPP_CONTROL_T
         ctrlParam;          /* Parameters for control references */
     
+    MCAPP_SCHEDULER_TASK_T
+        controlInputTask,   /* Rate of control input scaling */
+        speedLoopTask;      /* Rate of Speed Loop PI control */
+    
 }MCAPP_BLDC_SIXSTEP_CONTROL_T;
 
 // </editor-fold>
@@ -0,0 +1,117 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * @file profiler.c
+ *
+ * @brief This module measures the execution time of the sections of the
+ * control ISR using a free running cycle counter.
+ *
+ * Component: DIAGNOSTICS
+ *
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+
+#include <stdint.h>
+#include "profiler.h"
+#include "sccp2.h"
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="VARIABLES ">
+
+PROFILER_SECTION_DATA_T isrProfiler[PROFILER_SECTIONS];
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS ">
+
+/**
+* <B> Function: ProfilerInit() </B>
+*
+* @brief Function to start the cycle counter and reset the statistics.
+*
+* @param none.
+* @return none.
+*
+* @example
+* <CODE> ProfilerInit(); </CODE>
+*
+*/
+void ProfilerInit(void)
+{
+    SCCP2_Timer_Initialize();
+    SCCP2_Timer_Start();
+
+    ProfilerReset();
+}
+
+/**
+* <B> Function: ProfilerReset() </B>
+*
+* @brief Function to clear the statistics of all the profiled sections.
+*
+* @param none.
+* @return none.
+*
+* @example
+* <CODE> ProfilerReset(); </CODE>
+*
+*/
+void ProfilerReset(void)
+{
+    uint16_t section, bin;
+
+    for(section = 0; section < PROFILER_SECTIONS; section++)
+    {
+        isrProfiler[section].last        = 0;
+        isrProfiler[section].min         = UINT16_MAX;
+        isrProfiler[section].max         = 0;
+        isrProfiler[section].mean        = 0;
+        isrProfiler[section].windowSum   = 0;
+        isrProfiler[section].windowCount = 0;
+        isrProfiler[section].overBudget  = 0;
+
+        for(bin = 0; bin < PROFILER_HISTOGRAM_BINS; bin++)
+        {
+            isrProfiler[section].histogram[bin] = 0;
+        }
+    }
+}
+
+// </editor-fold>
@@ -0,0 +1,225 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * @file profiler.h
+ *
+ * @brief This header file lists data type definitions and interface functions
+ * of the ISR execution time profiler.
+ *
+ * Component: DIAGNOSTICS
+ *
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+
+#ifndef __PROFILER_H
+#define __PROFILER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+
+#include <stdint.h>
+#include "clock.h"
+#include "pwm.h"
+#include "sccp2.h"
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="DEFINITIONS/CONSTANTS ">
+
+/* Define ENABLE_ISR_PROFILER to measure the execution time of the sections of
+ * the control ISR, Undefine ENABLE_ISR_PROFILER to remove the instrumentation
+ * (default). The instrumentation itself adds counter reads and statistics 
+ * updates to the control ISR.
+ * Sections are timed independently and may be nested : a section measured 
+ * inside another one (e.g. PROFILER_MEASURE_SPEED and 
+ * PROFILER_CONTROL_STATE_MACHINE inside PROFILER_APP_STATE_MACHINE, and all 
+ * of them inside PROFILER_ADC_ISR) is also counted in the time of the outer 
+ * section, including the profiling overhead of the inner section. */
+#undef ENABLE_ISR_PROFILER
+
+/* Cycle counter used for the time stamps (unit : Tcy). The counter must be a
+ * free running 16-bit up counter; on target SCCP2 is used. */
+#ifndef PROFILER_CycleCounterRead
+#define PROFILER_CycleCounterRead()     SCCP2_TimerDataRead()
+#endif
+
+/* Share of the PWM period (percent) available to the control ISR; the rest
+ * is left for the Hall change notification ISR, the timer ISR and the main
+ * loop */
+#define PROFILER_BUDGET_PERCENT         80UL
+/* Execution time budget of the control ISR (unit : Tcy) */
+#define PROFILER_BUDGET_CYCLES          \
+            (uint16_t)(((FCY/PWMFREQUENCY_HZ) * PROFILER_BUDGET_PERCENT)/100)
+
+/* Histogram : bin width is 2^PROFILER_HISTOGRAM_SHIFT cycles,
+ * the last bin collects everything above the histogram range */
+#define PROFILER_HISTOGRAM_SHIFT        9
+#define PROFILER_HISTOGRAM_BINS         16
+
+/* Mean is computed over 2^PROFILER_MEAN_WINDOW_BITS executions */
+#define PROFILER_MEAN_WINDOW_BITS       8
+#define PROFILER_MEAN_WINDOW            (1 << PROFILER_MEAN_WINDOW_BITS)
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="ENUMERATED CONSTANTS ">
+
+typedef enum
+{
+    PROFILER_ADC_ISR = 0,               /* MC1_ADC_INTERRUPT */
+    PROFILER_APP_STATE_MACHINE = 1,     /* MC1APP_StateMachine */
+    PROFILER_CONTROL_STATE_MACHINE = 2, /* MCAPP_SixStepControlStateMachine */
+    PROFILER_MEASURE_SPEED = 3,         /* MCAPP_MeasureSpeed */
+    PROFILER_DIAGNOSTICS_ISR = 4,       /* DiagnosticsStepIsr */
+    PROFILER_SECTIONS = 5,              /* Number of profiled sections */
+
+}PROFILER_SECTION_T;
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="VARIABLE TYPE DEFINITIONS ">
+
+typedef struct
+{
+    uint16_t
+        start,              /* Cycle counter value at section entry */
+        last,               /* Last execution time */
+        min,                /* Minimum execution time */
+        max,                /* Maximum execution time */
+        mean,               /* Mean execution time of the last window */
+        windowCount,        /* Executions accumulated in the present window */
+        overBudget,         /* Executions longer than PROFILER_BUDGET_CYCLES */
+        histogram[PROFILER_HISTOGRAM_BINS]; /* Execution time distribution */
+
+    uint32_t
+        windowSum;          /* Accumulation of execution time for the mean */
+
+}PROFILER_SECTION_DATA_T;
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="VARIABLES ">
+
+extern PROFILER_SECTION_DATA_T isrProfiler[PROFILER_SECTIONS];
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS ">
+
+void ProfilerInit(void);
+void ProfilerReset(void);
+
+/**
+ * Stores the entry time stamp of a section.
+ * @example
+ * <code>
+ * ProfilerSectionStart(PROFILER_ADC_ISR);
+ * </code>
+ */
+inline static void ProfilerSectionStart(PROFILER_SECTION_T section)
+{
+    isrProfiler[section].start = PROFILER_CycleCounterRead();
+}
+
+/**
+ * Computes the execution time of a section and updates its statistics.
+ * @example
+ * <code>
+ * ProfilerSectionStop(PROFILER_ADC_ISR);
+ * </code>
+ */
+inline static void ProfilerSectionStop(PROFILER_SECTION_T section)
+{
+    PROFILER_SECTION_DATA_T *pSection = &isrProfiler[section];
+    uint16_t elapsed, bin;
+
+    /* Unsigned difference is valid across one counter roll over */
+    elapsed = (uint16_t)(PROFILER_CycleCounterRead() - pSection->start);
+    pSection->last = elapsed;
+
+    if(elapsed < pSection->min)
+    {
+        pSection->min = elapsed;
+    }
+    if(elapsed > pSection->max)
+    {
+        pSection->max = elapsed;
+    }
+    if(elapsed > PROFILER_BUDGET_CYCLES)
+    {
+        pSection->overBudget++;
+    }
+
+    bin = elapsed >> PROFILER_HISTOGRAM_SHIFT;
+    if(bin >= PROFILER_HISTOGRAM_BINS)
+    {
+        bin = PROFILER_HISTOGRAM_BINS - 1;
+    }
+    if(pSection->histogram[bin] < UINT16_MAX)
+    {
+        pSection->histogram[bin]++;
+    }
+
+    pSection->windowSum += elapsed;
+    pSection->windowCount++;
+    if(pSection->windowCount >= PROFILER_MEAN_WINDOW)
+    {
+        pSection->mean =
+                (uint16_t)(pSection->windowSum >> PROFILER_MEAN_WINDOW_BITS);
+        pSection->windowSum = 0;
+        pSection->windowCount = 0;
+    }
+}
+
+#ifdef ENABLE_ISR_PROFILER
+    #define PROFILER_SECTION_START(section)     ProfilerSectionStart(section)
+    #define PROFILER_SECTION_STOP(section)      ProfilerSectionStop(section)
+#else
+    #define PROFILER_SECTION_START(section)
+    #define PROFILER_SECTION_STOP(section)
+#endif
+
+// </editor-fold>
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __PROFILER_H */
@@ -42,6 +42,47 @@ extern "C" {
 ((Float_Value < 0.0) ? (int16_t)(32768 * (Float_Value) - 0.5) \
 : (int16_t)(32767 * (Float_Value) + 0.5))
 
+/* Fixed point arithmetic used by the control core.
+ * With XC-DSC these map to the single cycle DSP multiply and the 32/16 divide
+ * instructions; other compilers get plain C equivalents so that the control
+ * modules can be compiled natively against a register model. */
+inline static int32_t MCAPP_MulSS(int16_t a, int16_t b)
+{
+#ifdef __XC16__
+    return __builtin_mulss(a, b);
+#else
+    return (int32_t)a * (int32_t)b;
+#endif
+}
+
+inline static int32_t MCAPP_MulSU(int16_t a, uint16_t b)
+{
+#ifdef __XC16__
+    return __builtin_mulsu(a, b);
+#else
+    return (int32_t)a * (int32_t)b;
+#endif
+}
+
+inline static uint32_t MCAPP_MulUU(uint16_t a, uint16_t b)
+{
+#ifdef __XC16__
+    return __builtin_muluu(a, b);
+#else
+    return (uint32_t)a * (uint32_t)b;
+#endif
+}
+
+/* Quotient must fit in 16 bits, as with the DIV.UD instruction */
+inline static uint16_t MCAPP_DivUD(uint32_t numerator, uint16_t denominator)
+{
+#ifdef __XC16__
+    return __builtin_divud(numerator, denominator);
+#else
+    return (uint16_t)(numerator / denominator);
+#endif
+}
+
 #ifdef __cplusplus  // Provide C++ Compatibility
     }
 #endif
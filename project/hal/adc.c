@@ -296,8 +296,27 @@ void InitializeADCs (void)
     
     /*Selecting the Trigger Sources for ADC Channels*/
     
-    /* Trigger Source for Analog Input #0  = 0b0100 for Ibus*/
-    ADTRIG0Lbits.TRGSRC0  = 0x4;
+    /* Trigger Source for Analog Input #0  = 0b0101 (PWM1 ADC Trigger 2) for 
+       Ibus : converted at PG1TRIGB (and PG1TRIGC with oversampling) 
+       compare events */
+    ADTRIG0Lbits.TRGSRC0  = 0x5;
+    
+#ifdef ENABLE_IBUS_OVERSAMPLING
+    /* Initialize ADC DIGITAL FILTER 0 CONTROL REGISTER */
+    ADFL0CON = 0x0000;
+    /* Input Channel Selection bits : AN0 (Ibus) */
+    ADFL0CONbits.FLCHSEL = 0;
+    /* Filter Mode bits
+       11 = Averaging mode */
+    ADFL0CONbits.MODE = 0b11;
+    /* Oversampling Ratio bits (Averaging mode)
+       000 = 2x : one result per PWM cycle */
+    ADFL0CONbits.OVRSAM = 0;
+    /* Filter Common ADC Interrupt Enable bit : 0 = disabled */
+    ADFL0CONbits.IE = 0;
+    /* Filter Enable bit : 1 = enabled */
+    ADFL0CONbits.FLEN = 1;
+#endif
     /* Trigger Source for Analog Input #4  = 0b0100 for Va */
     ADTRIG2Hbits.TRGSRC10 = 0x4; 
     /* Trigger Source for Analog Input #4  = 0b0100 for Vb */
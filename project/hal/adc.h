@@ -58,11 +58,17 @@
 // <editor-fold defaultstate="collapsed" desc="HEADER FILES ">        
 #include <xc.h>
 #include <stdint.h>
+#include "mc1_user_params.h"
 // </editor-fold>         
 
 // <editor-fold defaultstate="collapsed" desc="DEFINITIONS/MACROS ">
       
+#ifdef ENABLE_IBUS_OVERSAMPLING
+/* Average of the bus current conversions, ADC digital filter 0 */
+#define ADCBUF_INV_A_IBUS         ADFL0DAT
+#else
 #define ADCBUF_INV_A_IBUS         ADCBUF0
+#endif
 #define ADCBUF_INV_A_VDC          ADCBUF15
 #define ADCBUF_INV_A_VA           ADCBUF10
 #define ADCBUF_INV_A_VB           ADCBUF11
@@ -65,6 +65,8 @@
 BUTTON_T buttonStartStop;
 BUTTON_T buttonDirectionChange;
 uint16_t boardServiceISRCounter = 0;
+/* ADC sampling point selected by SetADCSamplingPoint */
+uint16_t adcSamplingPoint = ADC_SAMPLING_POINT1;
 
 // </editor-fold>
 
@@ -72,6 +74,7 @@ uint16_t boardServiceISRCounter = 0;
 
 static void ButtonGroupInitialize(void);
 static void ButtonScan(BUTTON_T * ,bool);
+static void SetIbusSamplingPoints(uint16_t, uint16_t);
 
 // </editor-fold>
 
@@ -359,6 +362,16 @@ void HAL_MC1PWMEnableOutputs(void)
     PG1IOCONLbits.OVRENH = 0;  
     /* 0 = PWM generator provides data for PWM1L pin */
     PG1IOCONLbits.OVRENL = 0; 
+#ifdef ENABLE_COMPLEMENTARY_PWM
+    /* At zero duty complementary PWMxL would stay on; outputs remain off
+       until the commutation sequence releases the active legs */
+    PG3IOCONL = (PG3IOCONL & PWM_OVERRIDE_CLEAR_MASK) | PWM_OFF;
+    PG2IOCONL = (PG2IOCONL & PWM_OVERRIDE_CLEAR_MASK) | PWM_OFF;
+    PG1IOCONL = (PG1IOCONL & PWM_OVERRIDE_CLEAR_MASK) | PWM_OFF;
+#endif
+    
+    /* Latch the overrides of all generators at the next start of cycle */
+    PG1STATbits.UPDREQ = 1;
 }
 
 /**
@@ -403,6 +416,9 @@ void HAL_MC1PWMDisableOutputs(void)
     PG1IOCONLbits.OVRENH = 1;  
     /* 1 = OVRDAT<0> provides data for output on PWM1L */
     PG1IOCONLbits.OVRENL = 1;     
+    
+    /* Latch the overrides of all generators at the next start of cycle */
+    PG1STATbits.UPDREQ = 1;
 }
 
 /**
@@ -435,7 +451,8 @@ uint16_t HAL_MC1PWMDutyCycleLimitCheck(uint16_t dutycycle)
 /**
 * <B> Function: HAL_PWM_DutyCycleRegister_Set(uint16_t) </B>
 *
-* @brief Function to set the duty cycle values to the PDC registers
+* @brief Function to set the duty cycle values to the PDC registers and,
+*        with ADC_SAMPLING_POINT_DUTY selected, the bus current sampling point
 *        
 * @param duty value
 * @return none.
@@ -449,6 +466,15 @@ void HAL_PWM_DutyCycleRegister_Set(uint16_t pwmDC)
     uint16_t pwmDuty;
     
     pwmDuty = HAL_MC1PWMDutyCycleLimitCheck(pwmDC);
+    if(adcSamplingPoint == ADC_SAMPLING_POINT_DUTY)
+    {
+        /* PWMxH is on for the first pwmDuty counts of the first half : 
+           sample in the middle of that interval, ahead of PG1TRIGA. Written 
+           before PG1DC so that both are updated at the same start of cycle.
+           With oversampling, the samples are at one and three quarters of 
+           the on time */
+        SetIbusSamplingPoints((pwmDuty >> 1), (pwmDuty >> 1));
+    }
     PWM_PDC3 = (uint16_t)(pwmDuty);
     PWM_PDC2 = (uint16_t)(pwmDuty);
     PWM_PDC1 = (uint16_t)(pwmDuty);
@@ -495,6 +521,7 @@ void PWM1_OverrideEnableDataSet(uint16_t data)
     uint16_t dataBuffer;
     dataBuffer = PG1IOCONL & 0xC3FF;
     PG1IOCONL = dataBuffer | data;
+    PG1STATbits.UPDREQ = 1;
 }
 /**
 * <B> Function: PWM2_OverrideEnableDataSet(uint16_t) </B>
@@ -513,6 +540,7 @@ void PWM2_OverrideEnableDataSet(uint16_t data)
     uint16_t dataBuffer;
     dataBuffer = PG2IOCONL & 0xC3FF;
     PG2IOCONL = dataBuffer | data;
+    PG1STATbits.UPDREQ = 1;
 }
 /**
 * <B> Function: PWM3_OverrideEnableDataSet(uint16_t) </B>
@@ -531,6 +559,7 @@ void PWM3_OverrideEnableDataSet(uint16_t data)
     uint16_t dataBuffer;
     dataBuffer = PG3IOCONL & 0xC3FF;
     PG3IOCONL = dataBuffer | data;
+    PG1STATbits.UPDREQ = 1;
 }
 
 /**
@@ -580,7 +609,8 @@ void ClearPWMPCIFault(void)
 *
 * @brief Function to set the ADC sampling point.
 *        
-* @param none.
+* @param sampling point, ADC_SAMPLING_POINT_DUTY to have the sampling point
+*        follow the duty cycle set by HAL_PWM_DutyCycleRegister_Set.
 * @return none.
 * 
 * @example
@@ -589,7 +619,63 @@ void ClearPWMPCIFault(void)
 */
 void SetADCSamplingPoint(uint16_t value)
 {
-    PG1TRIGA = value;
+    adcSamplingPoint = value;
+    if(value != ADC_SAMPLING_POINT_DUTY)
+    {
+        PG1TRIGA = value;
+        /* The bus current samples are completed before PG1TRIGA, so that 
+           the control interrupt reads the conversions of the current cycle */
+        SetIbusSamplingPoints((value - ADC_IBUS_SAMPLE_MIN_SPACING), 0);
+    }
+    else
+    {
+        /* The control interrupt stays at a fixed point of the PWM cycle, 
+           only the bus current sampling point follows the duty cycle */
+        PG1TRIGA = ADC_SAMPLING_POINT1;
+    }
+}
+
+/**
+* <B> Function: SetIbusSamplingPoints(uint16_t, uint16_t) </B>
+*
+* @brief Function to set the bus current sampling point (PG1TRIGB, PWM1 ADC
+*        Trigger 2). With ENABLE_IBUS_OVERSAMPLING, the two samples of the 
+*        PWM cycle (PG1TRIGB and PG1TRIGC) are placed symmetrically around
+*        the sampling point. The spacing is at least 
+*        ADC_IBUS_SAMPLE_MIN_SPACING; the pair is moved back if it would 
+*        pass the end of the half cycle.
+*        
+* @param sampling point, PGxTRIGy format.
+* @param spacing of the samples in PWM counts.
+* @return none.
+* 
+* @example
+* <CODE> SetIbusSamplingPoints(samplingPoint, spacing); </CODE>
+*
+*/
+static void SetIbusSamplingPoints(uint16_t samplingPoint, uint16_t spacing)
+{
+#ifdef ENABLE_IBUS_OVERSAMPLING
+    uint16_t half, count;
+    
+    half = samplingPoint & ADC_SAMPLING_SECOND_HALF;
+    count = samplingPoint & ~ADC_SAMPLING_SECOND_HALF;
+    
+    if(spacing < ADC_IBUS_SAMPLE_MIN_SPACING)
+    {
+        spacing = ADC_IBUS_SAMPLE_MIN_SPACING;
+    }
+    count = count + (spacing >> 1);
+    if(count > LOOPTIME_TCY)
+    {
+        count = LOOPTIME_TCY;
+    }
+    PG1TRIGC = half | count;
+    PG1TRIGB = half | (count - spacing);
+#else
+    (void)spacing;
+    PG1TRIGB = samplingPoint;
+#endif
 }
 
 // </editor-fold>
\ No newline at end of file
@@ -115,9 +115,27 @@ typedef struct
 #define BUTTON_DEBOUNCE_COUNT       (BUTTON_DEBOUNCE_mSec/BOARD_SERVICE_TICK_mSec)
 
 /* PWM override macros for inverter switching */
+#ifdef ENABLE_COMPLEMENTARY_PWM
+#define DC_PLUS  0x0000  // Macro for DC+ state : PWMxH chopping, PWMxL complementary
+#define DC_MINUS 0x3400  // Macro for DC- state : PWMxL on
+#else
 #define DC_PLUS  0x1000  // Macro for DC+ state
 #define DC_MINUS 0x2000  // Macro for DC- state
+#endif
 #define PWM_OFF  0x3000  // Macro for OFF state
+
+/* Override bits OVRENH, OVRENL and OVRDAT<1:0> of PGxIOCONL */
+#define PWM_OVERRIDE_MASK       0x3C00
+#define PWM_OVERRIDE_CLEAR_MASK 0xC3FF
+/* Packs the override states of the three generators in one word : PWM3 in 
+ * bits 13-10, PWM2 in bits 9-6 and PWM1 in bits 5-2, so that each state is 
+ * moved to its PGxIOCONL position by a single shift. Evaluated at compile 
+ * time when the states are constants. */
+#define PWM_OVERRIDE_PACK(pwm3, pwm2, pwm1)     \
+            ((uint16_t)((pwm3) | ((pwm2) >> 4) | ((pwm1) >> 8)))
+/* Override state of generator pwm (1 to 3) in a packed word */
+#define PWM_OVERRIDE_UNPACK(data, pwm)          \
+            ((uint16_t)((data) << (4 * (3 - (pwm)))) & PWM_OVERRIDE_MASK)
 // </editor-fold>
 
 // <editor-fold defaultstate="collapsed" desc="INTERFACE FUNCTIONS ">
@@ -141,6 +159,33 @@ void PWM1_OverrideEnableDataSet(uint16_t );
 void PWM2_OverrideEnableDataSet(uint16_t );
 void PWM3_OverrideEnableDataSet(uint16_t );
 void SetADCSamplingPoint(uint16_t );
+
+/**
+* <B> Function: HAL_MC1PWMOverrideCommit(uint16_t) </B>
+*
+* @brief Function to override PWM3, PWM2 and PWM1 with one packed word.
+*        The overrides are staged in PGxIOCONL and latched together on the 
+*        start of cycle following the master update request, so the three 
+*        phases always change in the same PWM cycle.
+*        
+* @param override states packed by PWM_OVERRIDE_PACK.
+* @return none.
+* 
+* @example
+* <CODE> HAL_MC1PWMOverrideCommit(data); </CODE>
+*
+*/
+inline static void HAL_MC1PWMOverrideCommit(uint16_t data)
+{
+    PG3IOCONL = (PG3IOCONL & PWM_OVERRIDE_CLEAR_MASK) | 
+                    (data & PWM_OVERRIDE_MASK);
+    PG2IOCONL = (PG2IOCONL & PWM_OVERRIDE_CLEAR_MASK) | 
+                    ((data << 4) & PWM_OVERRIDE_MASK);
+    PG1IOCONL = (PG1IOCONL & PWM_OVERRIDE_CLEAR_MASK) | 
+                    ((data << 8) & PWM_OVERRIDE_MASK);
+    /* Master update request, broadcast to PWM2 and PWM3 */
+    PG1STATbits.UPDREQ = 1;
+}
 // </editor-fold
 
 #ifdef __cplusplus
@@ -61,6 +61,7 @@ extern "C" {
 #define MC1_HallCN_Interrupt       _CNDInterrupt  
 #define MC1_EnableCNInterrupt()    _CNDIE = 1
 #define MC1_DisableCNInterrupt()   _CNDIE = 0
+#define MC1_IsCNInterruptEnabled() (_CNDIE == 1)
 #define MC1_ClearCNIF()            _CNDIF = 0
 
 // </editor-fold>
@@ -0,0 +1,156 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * @file flash.c
+ *
+ * @brief This module erases, programs and reads the program flash memory
+ * through the NVM controller
+ *
+ * Definitions in this file are for dsPIC33CK256MP508
+ *
+ * Component: FLASH
+ *
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Header Files ">
+#include <xc.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "flash.h"
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS ">
+/**
+* <B> Function: FLASH_ErasePage(uint32_t) </B>
+*
+* @brief Function erases the flash page containing the address.
+*        CPU stalls while the page is erased.
+*
+* @param Program memory address within the page.
+* @return true if the erase completed without error.
+*
+* @example
+* <CODE> FLASH_ErasePage(address); </CODE>
+*
+*/
+bool FLASH_ErasePage(uint32_t address)
+{
+    address = address & FLASH_ERASE_PAGE_MASK;
+
+    NVMCON = FLASH_ERASE_PAGE_OPCODE;
+    NVMADR = (uint16_t)(address & 0xFFFF);
+    NVMADRU = (uint16_t)(address >> 16);
+
+    /* Unlock sequence and start of the erase */
+    __builtin_write_NVM();
+    while(NVMCONbits.WR == 1)
+    {
+    }
+    NVMCONbits.WREN = 0;
+
+    return (NVMCONbits.WRERR == 0);
+}
+
+/**
+* <B> Function: FLASH_WriteDoubleWord16(uint32_t, uint16_t, uint16_t) </B>
+*
+* @brief Function programs two 16-bit words into the lower 16 bits of two
+*        consecutive instruction words. The location must be erased.
+*
+* @param Program memory address, aligned to a double instruction word.
+* @param Data written at address.
+* @param Data written at address + 2.
+* @return true if the programming completed without error.
+*
+* @example
+* <CODE> FLASH_WriteDoubleWord16(address, data0, data1); </CODE>
+*
+*/
+bool FLASH_WriteDoubleWord16(uint32_t address, uint16_t data0, uint16_t data1)
+{
+    uint16_t tblpagSave = TBLPAG;
+
+    NVMCON = FLASH_WRITE_DOUBLE_WORD_OPCODE;
+
+    /* Load the write latches */
+    TBLPAG = FLASH_WRITE_LATCH_PAGE;
+    __builtin_tblwtl(0, data0);
+    __builtin_tblwth(0, 0x00);
+    __builtin_tblwtl(2, data1);
+    __builtin_tblwth(2, 0x00);
+
+    NVMADR = (uint16_t)(address & 0xFFFF);
+    NVMADRU = (uint16_t)(address >> 16);
+
+    /* Unlock sequence and start of the programming */
+    __builtin_write_NVM();
+    while(NVMCONbits.WR == 1)
+    {
+    }
+    NVMCONbits.WREN = 0;
+
+    TBLPAG = tblpagSave;
+
+    return (NVMCONbits.WRERR == 0);
+}
+
+/**
+* <B> Function: FLASH_ReadWord16(uint32_t) </B>
+*
+* @brief Function reads the lower 16 bits of an instruction word.
+*
+* @param Program memory address.
+* @return Data read.
+*
+* @example
+* <CODE> FLASH_ReadWord16(address); </CODE>
+*
+*/
+uint16_t FLASH_ReadWord16(uint32_t address)
+{
+    uint16_t tblpagSave = TBLPAG;
+    uint16_t data;
+
+    TBLPAG = (uint16_t)(address >> 16);
+    data = __builtin_tblrdl((uint16_t)(address & 0xFFFF));
+    TBLPAG = tblpagSave;
+
+    return data;
+}
+// </editor-fold>
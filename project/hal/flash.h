@@ -0,0 +1,92 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * @file flash.h
+ *
+ * @brief This header file lists the functions and definitions - to erase,
+ * program and read the program flash memory
+ *
+ * Definitions in this file are for dsPIC33CK256MP508
+ *
+ * Component: FLASH
+ *
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+
+#ifndef FLASH_H
+#define	FLASH_H
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+#include <xc.h>
+#include <stdint.h>
+#include <stdbool.h>
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="DEFINITIONS/CONSTANTS ">
+
+/* Erase page size : 1024 instructions, 2 program counter units each */
+#define FLASH_ERASE_PAGE_SIZE_IN_INSTRUCTIONS   1024
+#define FLASH_ERASE_PAGE_SIZE_IN_PC_UNITS       \
+                                    (FLASH_ERASE_PAGE_SIZE_IN_INSTRUCTIONS * 2)
+#define FLASH_ERASE_PAGE_MASK                   \
+                                    (~(FLASH_ERASE_PAGE_SIZE_IN_PC_UNITS - 1UL))
+
+/* NVMCON values : WREN = 1 and NVMOP */
+#define FLASH_WRITE_DOUBLE_WORD_OPCODE          0x4001
+#define FLASH_ERASE_PAGE_OPCODE                 0x4003
+
+/* Table page of the NVM write latches */
+#define FLASH_WRITE_LATCH_PAGE                  0x00FA
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS ">
+
+bool FLASH_ErasePage(uint32_t);
+bool FLASH_WriteDoubleWord16(uint32_t, uint16_t, uint16_t);
+uint16_t FLASH_ReadWord16(uint32_t);
+
+// </editor-fold>
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* FLASH_H */
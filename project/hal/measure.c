@@ -52,6 +52,7 @@
 
 #include "measure.h"
 #include "filter.h"
+#include "bemf_zero_cross.h"
 // </editor-fold>
 
 /**
@@ -70,6 +71,7 @@ void MCAPP_MeasureInit(MCAPP_MEASURE_T *pMotorInputs)
 {
     MCAPP_MeasureCurrentInit(pMotorInputs);
     MCAPP_HallSensorInit(&pMotorInputs->detectRotorPosition);
+    MCAPP_BemfZeroCrossInit(&pMotorInputs->bemfZeroCross);
 }
 
 /**
@@ -93,6 +95,10 @@ void MCAPP_MeasureCurrentInit(MCAPP_MEASURE_T *pMotorInputs)
     pCurrent->counter = 0;
     pCurrent->sumIbus = 0;
     pCurrent->status = 0;
+    
+    pMotorInputs->busCurrentFilter.qFilterOutput = 0;
+    pMotorInputs->busCurrentFilter.coefficient = IBUS_FILTER_COEFF;
+    pMotorInputs->busCurrentFilter.accumalator = 0;
 }
 
 /**
@@ -145,7 +151,8 @@ void MCAPP_MeasureCurrentCalibrate(MCAPP_MEASURE_T *pMotorInputs)
 
     pCurrent->Ibus = pCurrent->Ibus - pCurrent->offsetIbus;
     
-    pMotorInputs->filterBusCurrent = MCAPP_LowPassFilter(pMotorInputs->measureCurrent.Ibus);
+    pMotorInputs->filterBusCurrent = MCAPP_LowPassFilter(&pMotorInputs->busCurrentFilter,
+                                        pMotorInputs->measureCurrent.Ibus);
 
 }
 
@@ -56,6 +56,8 @@ extern "C" {
 
 #include <stdint.h>
 #include "hall_sensor.h"
+#include "bemf_zero_cross_types.h"
+#include "pwm.h"
 #include "mc1_user_params.h"
 // </editor-fold>
 
@@ -64,6 +66,15 @@ extern "C" {
 #define OFFSET_COUNT_BITS   (int16_t)10
 #define OFFSET_COUNT_MAX    (int16_t)(1 << OFFSET_COUNT_BITS)
 
+/* Bus current low pass filter coefficient : the averaged bus current samples
+   are less noisy and need less filtering. The filter runs every PWM cycle. 
+   The filtered bus current is also used by the identifier current limit */
+#ifdef ENABLE_IBUS_OVERSAMPLING
+#define IBUS_FILTER_COEFF   (int16_t)LOOP_RATE_SCALED(2000)
+#else
+#define IBUS_FILTER_COEFF   (int16_t)LOOP_RATE_SCALED(LFP_CUTOFF_FREQUENCY)
+#endif
+
 // </editor-fold>
 
 // <editor-fold defaultstate="collapsed" desc="VARIABLE TYPE DEFINITIONS ">
@@ -106,6 +117,9 @@ typedef struct
         measurePot,         /* Measure potentiometer */
         filterBusCurrent;
     
+    MCAPP_FILTER_LPF_T
+        busCurrentFilter;   /* Low pass filter for bus current */
+    
     MCAPP_MEASURE_CURRENT_T
         measureCurrent;     /* Current measurement parameters */
         
@@ -116,6 +130,8 @@ typedef struct
         measurePhaseVolt;   /* Phase voltage measurement parameters */
     MCAPP_HALL_SENSOR_T
         detectRotorPosition;/* Rotor position detection from sensors */
+    MCAPP_BEMF_ZC_T
+        bemfZeroCross;      /* Rotor position detection from the BEMF */
 }MCAPP_MEASURE_T;
 
 // </editor-fold>
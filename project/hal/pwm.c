@@ -51,6 +51,7 @@
 #include <xc.h>
 #include <stdint.h>
 #include "pwm.h"
+#include "mc1_user_params.h"
 
 // </editor-fold> 
 
@@ -191,6 +192,8 @@ void InitDutyPWM123Generators(void)
     PG3DC = 0;
     PG2DC = 0;      
     PG1DC = 0;
+    /* Latch the overrides of all generators at the next start of cycle */
+    PG1STATbits.UPDREQ = 1;
 
 }
 
@@ -232,9 +235,11 @@ void ChargeBootstarpCapacitors(void)
 
     /* PDCx: PWMx GENERATOR DUTY CYCLE REGISTER
      * Initialize the PWM duty cycle for charging */
-    PWM_PDC3 = LOOPTIME_TCY - (DDEADTIME/2 + 5);
-    PWM_PDC2 = LOOPTIME_TCY - (DDEADTIME/2 + 5);
-    PWM_PDC1 = LOOPTIME_TCY - (DDEADTIME/2 + 5);
+    PWM_PDC3 = BOOTSTRAP_CHARGING_DUTY;
+    PWM_PDC2 = BOOTSTRAP_CHARGING_DUTY;
+    PWM_PDC1 = BOOTSTRAP_CHARGING_DUTY;
+    /* Latch the overrides of all generators at the next start of cycle */
+    PG1STATbits.UPDREQ = 1;
     
     /*While loop for the Bootstrap charging time in number of PWM Half Cycles*/
     while(i)
@@ -248,55 +253,93 @@ void ChargeBootstarpCapacitors(void)
             {
                 i--; 
                 k++;
-                if(i == (BOOTSTRAP_CHARGING_COUNTS - 50))
+                if(i == (BOOTSTRAP_CHARGING_COUNTS - BOOTSTRAP_PHASE_DELAY_COUNTS))
                 {
                     /* 0 = PWM generator provides data for PWM1L pin */
                     PG1IOCONLbits.OVRENL = 0;
+                    PG1STATbits.UPDREQ = 1;
                 }
-                else if(i == (BOOTSTRAP_CHARGING_COUNTS - 150))
+                else if(i == (BOOTSTRAP_CHARGING_COUNTS - 
+                                        (3 * BOOTSTRAP_PHASE_DELAY_COUNTS)))
                 {
                     /* 0 = PWM generator provides data for PWM2L pin */
                     PG2IOCONLbits.OVRENL = 0;  
+                    PG1STATbits.UPDREQ = 1;
                 }
-                else if(i == (BOOTSTRAP_CHARGING_COUNTS - 250))
+                else if(i == (BOOTSTRAP_CHARGING_COUNTS - 
+                                        (5 * BOOTSTRAP_PHASE_DELAY_COUNTS)))
                 {
                     /* 0 = PWM generator provides data for PWM3L pin */
                     PG3IOCONLbits.OVRENL = 0;  
+                    PG1STATbits.UPDREQ = 1;
                 }
-                if(k > 25)
+                if(k >= BOOTSTRAP_DUTY_STEP_COUNTS)
                 {
                     if(PG3IOCONLbits.OVRENL == 0)
                     {
-                        if(PWM_PDC3 > 2)
+#ifdef ENABLE_COMPLEMENTARY_PWM
+                        if(PWM_PDC3 < (LOOPTIME_TCY - BOOTSTRAP_DUTY_STEP))
                         {
-                            PWM_PDC3 -= 2;
+                            PWM_PDC3 += BOOTSTRAP_DUTY_STEP;
+                        }
+                        else
+                        {
+                            PWM_PDC3 = LOOPTIME_TCY; 
+                        }
+#else
+                        if(PWM_PDC3 > BOOTSTRAP_DUTY_STEP)
+                        {
+                            PWM_PDC3 -= BOOTSTRAP_DUTY_STEP;
                         }
                         else
                         {
                            PWM_PDC3 = 0; 
                         }
+#endif
                     }
                     if(PG2IOCONLbits.OVRENL == 0)
                     {
-                        if(PWM_PDC2 > 2)
+#ifdef ENABLE_COMPLEMENTARY_PWM
+                        if(PWM_PDC2 < (LOOPTIME_TCY - BOOTSTRAP_DUTY_STEP))
                         {
-                            PWM_PDC2 -= 2;
+                            PWM_PDC2 += BOOTSTRAP_DUTY_STEP;
+                        }
+                        else
+                        {
+                            PWM_PDC2 = LOOPTIME_TCY; 
+                        }
+#else
+                        if(PWM_PDC2 > BOOTSTRAP_DUTY_STEP)
+                        {
+                            PWM_PDC2 -= BOOTSTRAP_DUTY_STEP;
                         }
                         else
                         {
                             PWM_PDC2 = 0; 
                         }
+#endif
                     }
                     if(PG1IOCONLbits.OVRENL == 0)
                     {
-                        if(PWM_PDC1 > 2)
+#ifdef ENABLE_COMPLEMENTARY_PWM
+                        if(PWM_PDC1 < (LOOPTIME_TCY - BOOTSTRAP_DUTY_STEP))
+                        {
+                            PWM_PDC1 += BOOTSTRAP_DUTY_STEP;
+                        }
+                        else
                         {
-                            PWM_PDC1 -= 2;
+                            PWM_PDC1 = LOOPTIME_TCY; 
+                        }
+#else
+                        if(PWM_PDC1 > BOOTSTRAP_DUTY_STEP)
+                        {
+                            PWM_PDC1 -= BOOTSTRAP_DUTY_STEP;
                         }
                         else
                         {
                             PWM_PDC1 = 0; 
                         }
+#endif
                     }
                     k = 0;
                 } 
@@ -310,10 +353,19 @@ void ChargeBootstarpCapacitors(void)
     PWM_PDC2 = 0;
     PWM_PDC1 = 0;
 
+#ifdef ENABLE_COMPLEMENTARY_PWM
+    /* 1 = OVRDAT<0> provides data for output on PWM3L,PWM2L and PWM1L;
+       at zero duty complementary PWMxL would stay on */
+    PG3IOCONLbits.OVRENL = 1;  
+    PG2IOCONLbits.OVRENL = 1;  
+    PG1IOCONLbits.OVRENL = 1;  
+#else
     /* 0 = PWM generator provides data for output on PWM3H,PWM2H and PWM1H*/
     PG3IOCONLbits.OVRENH = 0;  
     PG2IOCONLbits.OVRENH = 0;  
     PG1IOCONLbits.OVRENH = 0;  
+#endif
+    PG1STATbits.UPDREQ = 1;
 	
 }
 
@@ -400,9 +452,11 @@ void InitPWMGenerator1 (void)
        If OVERENL = 1, then OVRDAT<0> provides data for PWM1L */
     PG1IOCONLbits.OVRDAT = 0;
     /* User Output Override Synchronization Control bits
-       00 = User output overrides via the OVRENL/H and OVRDAT<1:0> bits are 
-       synchronized to the local PWM time base (next start of cycle)*/
-    PG1IOCONLbits.OSYNC = 0;
+       10 = User output overrides via the OVRENL/H and OVRDAT<1:0> bits are 
+       synchronized to the update of the PWM Generator (UPDMOD); the 
+       overrides of all generators are latched together on the master update
+       request */
+    PG1IOCONLbits.OSYNC = 0b10;
     /* Data for PWM1H/PWM1L Pins if FLT Event is Active bits
        If Fault is active, then FLTDAT<1> provides data for PWM1H.
        If Fault is active, then FLTDAT<0> provides data for PWM1L.*/
@@ -429,8 +483,13 @@ void InitPWMGenerator1 (void)
        0 = Dead-time compensation is controlled by PCI Sync logic */
     PG1IOCONHbits.DTCMPSEL = 0;
     /* PWM Generator Output Mode Selection bits
-	   01 = PWM Generator outputs operate in Independent mode*/
+       00 = PWM Generator outputs operate in Complementary mode
+       01 = PWM Generator outputs operate in Independent mode */
+#ifdef ENABLE_COMPLEMENTARY_PWM
+    PG1IOCONHbits.PMOD = 0;
+#else
     PG1IOCONHbits.PMOD = 1;
+#endif
     /* PWM1H Output Port Enable bit
        1 = PWM Generator controls the PWM1H output pin
        0 = PWM Generator does not control the PWM1H output pin */
@@ -492,14 +551,21 @@ void InitPWMGenerator1 (void)
        10 = Interrupts CPU at ADC Trigger 1 event
        11 = Time base interrupts are disabled */
     PG1EVTHbits.IEVTSEL = 3;
+#ifdef ENABLE_IBUS_OVERSAMPLING
+    /* ADC Trigger 2 Source is PG1TRIGC Compare Event Enable bit
+       1 = PG1TRIGC register compare event is enabled as 
+           trigger source for ADC Trigger 2 */
+    PG1EVTHbits.ADTR2EN3 = 1;
+#else
     /* ADC Trigger 2 Source is PG1TRIGC Compare Event Enable bit
        0 = PG1TRIGC register compare event is disabled as 
            trigger source for ADC Trigger 2 */
     PG1EVTHbits.ADTR2EN3 = 0;
+#endif
     /* ADC Trigger 2 Source is PG1TRIGB Compare Event Enable bit
-       0 = PG1TRIGB register compare event is disabled as 
-           trigger source for ADC Trigger 2 */
-    PG1EVTHbits.ADTR2EN2 = 0;
+       1 = PG1TRIGB register compare event is enabled as 
+           trigger source for ADC Trigger 2 (Ibus) */
+    PG1EVTHbits.ADTR2EN2 = 1;
     /* ADC Trigger 2 Source is PG1TRIGA Compare Event Enable bit
        0 = PG1TRIGA register compare event is disabled as 
            trigger source for ADC Trigger 2 */
@@ -690,9 +756,17 @@ void InitPWMGenerator1 (void)
     /* Initialize PWM GENERATOR 1 TRIGGER A REGISTER */
     PG1TRIGA     = ADC_SAMPLING_POINT1;
     /* Initialize PWM GENERATOR 1 TRIGGER B REGISTER */
-    PG1TRIGB     = 0x0000;
+#ifdef ENABLE_IBUS_OVERSAMPLING
+    PG1TRIGB     = ADC_SAMPLING_POINT1 - (2 * ADC_IBUS_SAMPLE_MIN_SPACING);
+#else
+    PG1TRIGB     = ADC_SAMPLING_POINT1;
+#endif
     /* Initialize PWM GENERATOR 1 TRIGGER C REGISTER */
+#ifdef ENABLE_IBUS_OVERSAMPLING
+    PG1TRIGC     = ADC_SAMPLING_POINT1 - ADC_IBUS_SAMPLE_MIN_SPACING;
+#else
     PG1TRIGC     = 0x0000;
+#endif
     
 } 
 
@@ -781,9 +855,11 @@ void InitPWMGenerator2 (void)
        If OVERENL = 1, then OVRDAT<0> provides data for PWM2L */
     PG2IOCONLbits.OVRDAT = 0;
     /* User Output Override Synchronization Control bits
-       00 = User output overrides via the OVRENL/H and OVRDAT<1:0> bits are 
-       synchronized to the local PWM time base (next start of cycle)*/
-    PG2IOCONLbits.OSYNC = 0;
+       10 = User output overrides via the OVRENL/H and OVRDAT<1:0> bits are 
+       synchronized to the update of the PWM Generator (UPDMOD); the 
+       overrides of all generators are latched together on the master update
+       request */
+    PG2IOCONLbits.OSYNC = 0b10;
     /* Data for PWM2H/PWM2L Pins if FLT Event is Active bits
        If Fault is active, then FLTDAT<1> provides data for PWM2H.
        If Fault is active, then FLTDAT<0> provides data for PWM2L.*/
@@ -810,8 +886,13 @@ void InitPWMGenerator2 (void)
        0 = Dead-time compensation is controlled by PCI Sync logic */
     PG2IOCONHbits.DTCMPSEL = 0;
     /* PWM Generator Output Mode Selection bits
-        01 = PWM Generator outputs operate in Independent mode */
+       00 = PWM Generator outputs operate in Complementary mode
+       01 = PWM Generator outputs operate in Independent mode */
+#ifdef ENABLE_COMPLEMENTARY_PWM
+    PG2IOCONHbits.PMOD = 0;
+#else
     PG2IOCONHbits.PMOD = 1;
+#endif
     /* PWM2H Output Port Enable bit
        1 = PWM Generator controls the PWM2H output pin
        0 = PWM Generator does not control the PWM2H output pin */
@@ -1163,9 +1244,11 @@ void InitPWMGenerator3 (void)
        If OVERENL = 1, then OVRDAT<0> provides data for PWM3L */
     PG3IOCONLbits.OVRDAT = 0;
     /* User Output Override Synchronization Control bits
-       00 = User output overrides via the OVRENL/H and OVRDAT<1:0> bits are 
-       synchronized to the local PWM time base (next start of cycle)*/
-    PG3IOCONLbits.OSYNC = 0;
+       10 = User output overrides via the OVRENL/H and OVRDAT<1:0> bits are 
+       synchronized to the update of the PWM Generator (UPDMOD); the 
+       overrides of all generators are latched together on the master update
+       request */
+    PG3IOCONLbits.OSYNC = 0b10;
     /* Data for PWM3H/PWM3L Pins if FLT Event is Active bits
        If Fault is active, then FLTDAT<1> provides data for PWM3H.
        If Fault is active, then FLTDAT<0> provides data for PWM3L.*/
@@ -1192,8 +1275,13 @@ void InitPWMGenerator3 (void)
        0 = Dead-time compensation is controlled by PCI Sync logic */
     PG3IOCONHbits.DTCMPSEL = 0;
     /* PWM Generator Output Mode Selection bits
-       01 = PWM Generator outputs operate in Independent mode*/
+       00 = PWM Generator outputs operate in Complementary mode
+       01 = PWM Generator outputs operate in Independent mode */
+#ifdef ENABLE_COMPLEMENTARY_PWM
+    PG3IOCONHbits.PMOD = 0;
+#else
     PG3IOCONHbits.PMOD = 1;
+#endif
     /* PWM3H Output Port Enable bit
        1 = PWM Generator controls the PWM3H output pin
        0 = PWM Generator does not control the PWM3H output pin */
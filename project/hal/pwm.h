@@ -69,6 +69,11 @@
 #define ENABLE_PWM_FAULT
 /* Define to enable PWM Current Limit PCI*/ 
 #define CYCLE_BY_CYCLE_CURRENT_LIMIT
+/* Define to operate PWM generators in complementary mode : the low side of 
+   the chopping leg conducts during the PWM off time (synchronous 
+   rectification) instead of the body diodes. Undefine to switch one high 
+   side and one low side in independent mode */
+#undef ENABLE_COMPLEMENTARY_PWM
 
 
 /* MC PWM MODULE Related Definitions  */      
@@ -82,6 +87,27 @@
   
 /* Calculate Bootstrap charging time in number of PWM Half Cycles */
 #define BOOTSTRAP_CHARGING_COUNTS (uint16_t)((BOOTSTRAP_CHARGING_TIME_SECS/LOOPTIME_SEC )* 2)
+/* PWM1L, PWM2L and PWM3L are released to the PWM generators 1, 3 and 5 
+   delays after the start of charging */
+#define BOOTSTRAP_PHASE_DELAY_COUNTS (uint16_t)(BOOTSTRAP_CHARGING_COUNTS/8)
+/* PWMxL on time of the released phases is ramped down by changing the duty
+   by BOOTSTRAP_DUTY_STEP every BOOTSTRAP_DUTY_STEP_TIME_SECS (down to zero, 
+   or up to LOOPTIME_TCY in complementary mode) : the step is a fixed 
+   fraction of the PWM period, so that the ramp takes the same share of the
+   period at any PWM frequency (2 counts every 26 periods at 20kHz) */
+#define BOOTSTRAP_DUTY_STEP_TIME_SECS   0.00065
+#define BOOTSTRAP_DUTY_STEP_COUNTS  \
+            (uint16_t)((BOOTSTRAP_DUTY_STEP_TIME_SECS/LOOPTIME_SEC)* 2)
+#define BOOTSTRAP_DUTY_STEP_RATIO       0.0004f
+#define BOOTSTRAP_DUTY_STEP         \
+            (uint16_t)(((float)LOOPTIME_TCY*BOOTSTRAP_DUTY_STEP_RATIO) + 0.5f)
+/* Initial duty for bootstrap charging : PWMxL on for almost the full period.
+   In complementary mode PWMxL is the inverse of the duty */
+#ifdef ENABLE_COMPLEMENTARY_PWM
+#define BOOTSTRAP_CHARGING_DUTY   (DDEADTIME/2 + 5)
+#else
+#define BOOTSTRAP_CHARGING_DUTY   (LOOPTIME_TCY - (DDEADTIME/2 + 5))
+#endif
         
 
 #define PWM_FAULT_STATUS        PG1STATbits.FLTACT
@@ -91,21 +117,47 @@
 #define EnablePWMIF()           _PWM1IE = 1
 #define DisablePWMIF()          _PWM1IE = 0
  
-/*Specify PWM Switching Frequency in Hertz*/
-#define PWMFREQUENCY_HZ         20000
+/*Specify PWM Switching Frequency in Hertz. The control ISR runs once per
+  PWM period : all loop timing below is derived from this value. Before 
+  raising it, check isrProfiler[PROFILER_ADC_ISR].max and .overBudget at the
+  new frequency (ENABLE_ISR_PROFILER) */
+#define PWMFREQUENCY_HZ         20000UL
+#if (PWMFREQUENCY_HZ < 10000UL) || (PWMFREQUENCY_HZ > 50000UL)
+#error "PWMFREQUENCY_HZ must be in the range 10kHz to 50kHz"
+#endif
+/* PWM frequency the per cycle controller gains and filter coefficients
+   (PI integral terms, low pass filter coefficients) are specified for */
+#define PWMFREQUENCY_TUNING_HZ  20000UL
+/* Scales a per cycle gain specified at PWMFREQUENCY_TUNING_HZ to the 
+   configured PWM frequency, so that its time constant is unchanged */
+#define LOOP_RATE_SCALED(value) \
+            (((int32_t)(value) * (int32_t)PWMFREQUENCY_TUNING_HZ) / \
+                                                (int32_t)PWMFREQUENCY_HZ)
 /* Specify PWM module dead time in micro seconds*/
 #define DEADTIME_MICROSEC       1.0
 /* Loop Time in seconds, (1/ PWMFREQUENCY_HZ) */
-#define LOOPTIME_SEC            0.00005
+#define LOOPTIME_SEC            (1.0f/(float)PWMFREQUENCY_HZ)
 /* Loop Time in micro seconds*/
-#define LOOPTIME_MICROSEC       50       
+#define LOOPTIME_MICROSEC       (1000000UL/PWMFREQUENCY_HZ)
 #define DDEADTIME               (uint16_t)(DEADTIME_MICROSEC*FOSC_MHZ)
 /*Loop time in terms of PWM clock period*/
-#define LOOPTIME_TCY            (uint16_t)(((LOOPTIME_MICROSEC*FOSC_MHZ)/2)-1)
+#define LOOPTIME_TCY            (uint16_t)(((FOSC/PWMFREQUENCY_HZ)/2)-1)
 
 /*Specify ADC Triggering Point w.r.t PWM Output for sensing Analog Inputs*/ 
-#define ADC_SAMPLING_POINT1      0x89C2 /* (32767 + 2499) */
-#define ADC_SAMPLING_POINT2      0x09C3 /* (2499) */
+/* Middle of the second half of the PWM cycle (0x89C2 at 20kHz) */
+#define ADC_SAMPLING_POINT1      (uint16_t)(0x8000 | ((LOOPTIME_TCY/2) - 1))
+/* Middle of the first half of the PWM cycle (0x09C3 at 20kHz) */
+#define ADC_SAMPLING_POINT2      (uint16_t)(LOOPTIME_TCY/2)
+/* Sampling point following the duty cycle : the bus current (PG1TRIGB) is
+   sampled in the middle of the PWMxH on time of the first half of the PWM 
+   cycle, so that it is sampled during conduction at any duty cycle. The 
+   other inputs and the control interrupt stay at ADC_SAMPLING_POINT1 */
+#define ADC_SAMPLING_POINT_DUTY  0xFFFF
+/* PGxTRIGy bit selecting the second half of the center-aligned PWM cycle */
+#define ADC_SAMPLING_SECOND_HALF 0x8000
+/* Minimum spacing of the two bus current samples with bus current 
+   oversampling : one AN0 conversion time (1 micro second) */
+#define ADC_IBUS_SAMPLE_MIN_SPACING   (uint16_t)(FOSC_MHZ/2)
         
 #define MIN_DUTY            0
 #define MAX_DUTY            MPER-1 
@@ -0,0 +1,113 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * @file sccp2.c
+ *
+ * @brief This module configures SCCP2 Module as a free running 16-bit timer
+ * clocked at Tcy, used as the cycle counter for execution time measurement
+ *
+ * Definitions in this file are for dsPIC33CK256MP508
+ *
+ * Component: SCCP2
+ *
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Header Files ">
+#include <xc.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "sccp2.h"
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS ">
+/**
+* <B> Function: SCCP2_Timer_Initialize() </B>
+*
+* @brief Function configures SCCP2 Module in 16bit free running timer mode
+*
+* @param none.
+* @return none.
+*
+* @example
+* <CODE> SCCP2_Timer_Initialize(); </CODE>
+*
+*/
+void SCCP2_Timer_Initialize(void)
+{
+    /* Set SCCP2 operating OFF */
+    CCP2CON1Lbits.CCSEL = 0;
+    /* Set timebase width (16-bit = 0) */
+    CCP2CON1Lbits.T32 = 0;
+    /* Set mode to 16/32 bit timer mode features to Output Timer Mode */
+    CCP2CON1Lbits.MOD = 0b0000;
+    /* No external synchronization; timer rolls over at FFFFh */
+    CCP2CON1Hbits.SYNC = 0b00000;
+    /* Set timebase synchronization (Synchronized) */
+    CCP2CON1Lbits.TMRSYNC = 0;
+    /* Set the clock source (Tcy) */
+    CCP2CON1Lbits.CLKSEL = 0b000;
+    /* Set the clock pre-scaler (1:1) */
+    CCP2CON1Lbits.TMRPS = 0b00;
+    /* Set Sync/Triggered mode (Synchronous) */
+    CCP2CON1Hbits.TRIGEN = 0;
+
+    /* Initialize timer prior to enable module. */
+    CCP2TMRL = 0x0000;
+    /* Initialize timer prior to enable module. */
+    CCP2TMRH = 0x0000;
+
+    /* Set timer period register low */
+    CCP2PRL = 0xFFFF;
+    /* Set timer period register high */
+    CCP2PRH = 0x0000;
+
+    /* Clear Interrupt flag */
+    _CCT2IF = 0;
+    /* Disable Interrupt */
+    _CCT2IE = 0;
+    /* Disable CCP/input capture */
+    CCP2CON1Lbits.CCPON = 0;
+}
+
+void SCCP2_Timer_Start(void)
+{
+    /* Start the Timer */
+    CCP2CON1Lbits.CCPON = true;
+}
+// </editor-fold>
@@ -0,0 +1,93 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * @file sccp2.h
+ *
+ * @brief This header file lists the functions and definitions - to configure
+ * and enable SCCP2 Module as a free running time base
+ *
+ * Component: SCCP2
+ *
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+
+#ifndef SCCP2_H
+#define	SCCP2_H
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+#include <xc.h>
+#include <stdint.h>
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS ">
+
+void SCCP2_Timer_Initialize(void);
+
+/**
+ * Starts SCCP2 Timer module.
+ * Summary: Starts SCCP2 Timer module.
+ * @example
+ * <code>
+ * SCCP2_Timer_Start();
+ * </code>
+ */
+void SCCP2_Timer_Start(void);
+
+/**
+ * Read timer counter.
+ * Summary: Read the 16-bit free running timer counter (unit : Tcy).
+ * @example
+ * <code>
+ * SCCP2_TimerDataRead();
+ * </code>
+ */
+inline static uint16_t SCCP2_TimerDataRead(void)
+{
+    return CCP2TMRL;
+}
+
+// </editor-fold>
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* SCCP2_H */
+
@@ -0,0 +1,336 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * @file bemf_zero_cross.c
+ *
+ * @brief This module detects the zero crossings of the BEMF of the floating 
+ * phase from the phase voltages sampled every PWM period.
+ * 
+ * While the motor runs on the Hall sensors the detector follows the 
+ * commutation and checks that a zero crossing is found in every sector. 
+ * After a Hall sensor failure it can take over the commutation : the next 
+ * sector is applied half a sector (30 degrees electrical) after the zero 
+ * crossing, in the order of the identified Hall sequence.
+ * 
+ * The floating phase of a sector is the phase whose PWM outputs are both 
+ * overridden off (PWM_OFF) in the identified commutation table. Its voltage is
+ * compared with half the DC bus voltage, sampled during the PWM on time.
+ * Phase and DC bus voltages are assumed to have the same scaling.
+ *
+ * Component: BEMF ZERO CROSSING
+ *
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+#include <stdint.h>
+#include <stdbool.h>
+#include "bemf_zero_cross.h"
+#include "board_service.h"
+#include "general.h"
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="STATIC FUNCTIONS ">
+
+static void MCAPP_BemfSectorStart(MCAPP_BEMF_ZC_T *, uint16_t, uint16_t);
+static void MCAPP_BemfCommutate(MCAPP_BEMF_ZC_T *);
+
+// </editor-fold>
+
+/**
+* <B> Function: MCAPP_BemfZeroCrossInit(&pBemf) </B>
+*
+* @brief Function to reset the detector; it does not commutate until
+*        MCAPP_BemfZeroCrossTakeOver is called.
+*        
+* @param Pointer to the data structure containing BEMF detector parameters.
+* @return none.
+* 
+* @example
+* <CODE> MCAPP_BemfZeroCrossInit(&pBemf); </CODE>
+*
+*/
+void MCAPP_BemfZeroCrossInit(MCAPP_BEMF_ZC_T *pBemf)
+{
+    uint16_t i;
+    
+    pBemf->hallValue        = BEMF_HALL_VALUE_NONE;
+    pBemf->floatingPhase    = BEMF_PHASE_NONE;
+    pBemf->sign             = BEMF_SIGN_UNKNOWN;
+    pBemf->sectorTicks      = 0;
+    pBemf->zeroCrossTicks   = 0;
+    for(i = 0; i < HALL_SECTORS; i++)
+    {
+        pBemf->sectorPeriod[i] = 0;
+    }
+    pBemf->periodIndex      = 0;
+    pBemf->periodSum        = 0;
+    pBemf->lockCount        = 0;
+    pBemf->positionIndex    = 0;
+    pBemf->direction        = 0;
+    pBemf->commutationValue = 0;
+    pBemf->speed            = 0;
+    pBemf->sampleCount      = 0;
+    pBemf->locked           = false;
+    pBemf->active           = false;
+    pBemf->failure          = false;
+}
+
+/**
+* <B> Function: MCAPP_BemfZeroCrossStep(&pBemf, &pPhaseVolt, int16_t) </B>
+*
+* @brief Function to detect the BEMF zero crossing of the floating phase. To 
+*        be called every control period before the control state machine, 
+*        as the samples belong to the commutation applied in the previous 
+*        control period. When active, commutates half the average sector 
+*        length after the zero crossing, and sets failure if no zero crossing
+*        is found within two average sector lengths.
+*        
+* @param Pointer to the data structure containing BEMF detector parameters.
+* @param Pointer to the measured phase voltages.
+* @param Measured DC bus voltage.
+* @return none.
+* 
+* @example
+* <CODE> MCAPP_BemfZeroCrossStep(&pBemf, &pPhaseVolt, vdc); </CODE>
+*
+*/
+void MCAPP_BemfZeroCrossStep(MCAPP_BEMF_ZC_T *pBemf, 
+                        MCAPP_MEASURE_PHASEVOLT_T *pPhaseVolt, int16_t vdc)
+{
+    uint16_t voltage, halfBus, blanking, average;
+    uint16_t sign;
+    
+    if(*(pBemf->pHallValue) != pBemf->hallValue)
+    {
+        MCAPP_BemfSectorStart(pBemf, *(pBemf->pHallValue), 
+                                                    *(pBemf->pTableIndex));
+    }
+    else if(pBemf->sectorTicks < BEMF_SECTOR_TICKS_MAX)
+    {
+        pBemf->sectorTicks++;
+    }
+    
+    if(pBemf->floatingPhase == BEMF_PHASE_NONE)
+    {
+        return;
+    }
+    
+    average = pBemf->periodSum / HALL_SECTORS;
+    blanking = average >> BEMF_BLANKING_SHIFT;
+    if(blanking < BEMF_BLANKING_MIN_TICKS)
+    {
+        blanking = BEMF_BLANKING_MIN_TICKS;
+    }
+    
+    if(pBemf->sectorTicks >= blanking)
+    {
+        /* Unsigned fractional ADC results */
+        if(pBemf->floatingPhase == 0)
+        {
+            voltage = (uint16_t)pPhaseVolt->Va >> 1;
+        }
+        else if(pBemf->floatingPhase == 1)
+        {
+            voltage = (uint16_t)pPhaseVolt->Vb >> 1;
+        }
+        else
+        {
+            voltage = (uint16_t)pPhaseVolt->Vc >> 1;
+        }
+        halfBus = (uint16_t)vdc >> 2;
+        sign = (voltage > halfBus) ? BEMF_SIGN_ABOVE : BEMF_SIGN_BELOW;
+        
+        if(pBemf->sign == BEMF_SIGN_UNKNOWN)
+        {
+            pBemf->sign = sign;
+        }
+        else if((pBemf->zeroCrossTicks == 0) && (sign != pBemf->sign))
+        {
+            pBemf->zeroCrossTicks = pBemf->sectorTicks;
+        }
+    }
+    
+    if(pBemf->active)
+    {
+        if(pBemf->zeroCrossTicks != 0)
+        {
+            if(pBemf->sectorTicks >= (pBemf->zeroCrossTicks + (average >> 1)))
+            {
+                MCAPP_BemfCommutate(pBemf);
+            }
+        }
+        else if(pBemf->sectorTicks > (average << 1))
+        {
+            pBemf->failure = true;
+        }
+    }
+}
+
+/**
+* <B> Function: MCAPP_BemfZeroCrossTakeOver(&pBemf, uint16_t) </B>
+*
+* @brief Function to let the detector commutate the motor, starting from the
+*        sector being commutated. Only possible once zero crossings have 
+*        been found in the last BEMF_LOCK_SECTORS sectors.
+*        
+* @param Pointer to the data structure containing BEMF detector parameters.
+* @param Direction of rotation : 0 = increasing position index.
+* @return true if the detector has taken over the commutation.
+* 
+* @example
+* <CODE> MCAPP_BemfZeroCrossTakeOver(&pBemf, direction); </CODE>
+*
+*/
+bool MCAPP_BemfZeroCrossTakeOver(MCAPP_BEMF_ZC_T *pBemf, uint16_t direction)
+{
+    uint16_t index;
+    
+    if((pBemf->locked == false) || (pBemf->hallValue == BEMF_HALL_VALUE_NONE))
+    {
+        return false;
+    }
+    index = pBemf->pPositionMap[pBemf->hallValue & (HALL_STATES - 1)];
+    if(index >= HALL_SECTORS)
+    {
+        return false;
+    }
+    
+    pBemf->positionIndex    = index;
+    pBemf->direction        = direction;
+    pBemf->commutationValue = pBemf->hallValue;
+    pBemf->speed = MCAPP_DivUD(pBemf->speedMultiplier, pBemf->periodSum);
+    pBemf->sampleCount++;
+    pBemf->failure          = false;
+    pBemf->active           = true;
+    
+    return true;
+}
+
+/**
+* <B> Function: MCAPP_BemfSectorStart(&pBemf, uint16_t, uint16_t) </B>
+*
+* @brief Function to close the present sector and start the next one : 
+*        records the sector length and whether a zero crossing was found, 
+*        and looks up the floating phase of the new commutation pattern.
+*        
+* @param Pointer to the data structure containing BEMF detector parameters.
+* @param Hall value being commutated.
+* @param Commutation table index applied.
+* @return none.
+* 
+* @example
+* <CODE> MCAPP_BemfSectorStart(&pBemf, hallValue, tableIndex); </CODE>
+*
+*/
+static void MCAPP_BemfSectorStart(MCAPP_BEMF_ZC_T *pBemf, uint16_t hallValue,
+                                    uint16_t tableIndex)
+{
+    uint16_t pattern, pwm;
+    
+    if(pBemf->hallValue != BEMF_HALL_VALUE_NONE)
+    {
+        if(pBemf->zeroCrossTicks != 0)
+        {
+            if(pBemf->lockCount < BEMF_LOCK_SECTORS)
+            {
+                pBemf->lockCount++;
+            }
+        }
+        else
+        {
+            pBemf->lockCount = 0;
+        }
+        
+        pBemf->periodSum -= pBemf->sectorPeriod[pBemf->periodIndex];
+        pBemf->sectorPeriod[pBemf->periodIndex] = pBemf->sectorTicks;
+        pBemf->periodSum += pBemf->sectorTicks;
+        pBemf->periodIndex = (pBemf->periodIndex == (HALL_SECTORS - 1)) ?
+                                                0 : (pBemf->periodIndex + 1);
+        
+        if(pBemf->active && (pBemf->periodSum != 0))
+        {
+            pBemf->speed = MCAPP_DivUD(pBemf->speedMultiplier, 
+                                                        pBemf->periodSum);
+            pBemf->sampleCount++;
+        }
+    }
+    pBemf->locked = (pBemf->lockCount >= BEMF_LOCK_SECTORS);
+    
+    pBemf->hallValue        = hallValue;
+    pBemf->sectorTicks      = 0;
+    pBemf->zeroCrossTicks   = 0;
+    pBemf->sign             = BEMF_SIGN_UNKNOWN;
+    
+    pBemf->floatingPhase    = BEMF_PHASE_NONE;
+    pattern = pBemf->pOverrideTable[tableIndex & (HALL_STATES - 1)];
+    for(pwm = 1; pwm <= 3; pwm++)
+    {
+        if(PWM_OVERRIDE_UNPACK(pattern, pwm) == PWM_OFF)
+        {
+            /* PWM1 to PWM3 drive phases A to C */
+            pBemf->floatingPhase = pwm - 1;
+        }
+    }
+}
+
+/**
+* <B> Function: MCAPP_BemfCommutate(&pBemf) </B>
+*
+* @brief Function to select the Hall value of the next sector in the 
+*        direction of rotation for commutation.
+*        
+* @param Pointer to the data structure containing BEMF detector parameters.
+* @return none.
+* 
+* @example
+* <CODE> MCAPP_BemfCommutate(&pBemf); </CODE>
+*
+*/
+static void MCAPP_BemfCommutate(MCAPP_BEMF_ZC_T *pBemf)
+{
+    if(pBemf->direction == 0)
+    {
+        pBemf->positionIndex = (pBemf->positionIndex == (HALL_SECTORS - 1)) ?
+                                            0 : (pBemf->positionIndex + 1);
+    }
+    else
+    {
+        pBemf->positionIndex = (pBemf->positionIndex == 0) ?
+                                (HALL_SECTORS - 1) : (pBemf->positionIndex - 1);
+    }
+    pBemf->commutationValue = pBemf->pHallValueAt[pBemf->positionIndex];
+}
@@ -0,0 +1,90 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * @file bemf_zero_cross.h
+ *
+ * @brief This header file lists definitions and interface functions of the
+ * BEMF zero crossing detector, used to commutate the motor without the Hall
+ * sensors after a Hall sensor failure.
+ * 
+ * Component: BEMF ZERO CROSSING 
+ * 
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+#ifndef BEMF_ZERO_CROSS_H
+#define	BEMF_ZERO_CROSS_H
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "bemf_zero_cross_types.h"
+#include "measure.h"
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="DEFINITIONS/CONSTANTS ">
+
+/* Sectors in a row with a zero crossing before the detector may take over */
+#define BEMF_LOCK_SECTORS           12
+/* Samples ignored after a commutation while the current of the phase that 
+ * has become floating decays through the diodes : at least 
+ * BEMF_BLANKING_MIN_TICKS, and 1/2^BEMF_BLANKING_SHIFT of the sector */
+#define BEMF_BLANKING_MIN_TICKS     2
+#define BEMF_BLANKING_SHIFT         3
+/* Sector length limit (control periods); HALL_SECTORS times this must fit 
+ * in 16 bits */
+#define BEMF_SECTOR_TICKS_MAX       10000
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS ">
+
+void MCAPP_BemfZeroCrossInit(MCAPP_BEMF_ZC_T *);
+void MCAPP_BemfZeroCrossStep(MCAPP_BEMF_ZC_T *, MCAPP_MEASURE_PHASEVOLT_T *,
+                                int16_t);
+bool MCAPP_BemfZeroCrossTakeOver(MCAPP_BEMF_ZC_T *, uint16_t);
+
+// </editor-fold> 
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* BEMF_ZERO_CROSS_H */
@@ -0,0 +1,123 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * @file bemf_zero_cross_types.h
+ *
+ * @brief This module initializes data structure variable type definitions of 
+ * the BEMF zero crossing detector
+ * 
+ * 
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+#ifndef BEMF_ZERO_CROSS_TYPES_H
+#define	BEMF_ZERO_CROSS_TYPES_H
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hall_sensor_types.h"
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="DEFINITIONS/CONSTANTS ">
+
+/* Hall value before the first commutation is seen */
+#define BEMF_HALL_VALUE_NONE        0xFFFF
+/* Floating phase of a commutation pattern without one */
+#define BEMF_PHASE_NONE             3
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="ENUMERATED CONSTANTS ">
+
+typedef enum
+{
+    BEMF_SIGN_UNKNOWN = 0,      /* Sampled in the blanking time */
+    BEMF_SIGN_BELOW = 1,        /* Floating phase below half the DC bus */
+    BEMF_SIGN_ABOVE = 2,        /* Floating phase above half the DC bus */
+            
+}MCAPP_BEMF_SIGN_T;
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="VARIABLE TYPE DEFINITIONS ">
+
+typedef struct
+{
+    uint16_t
+        *pHallValue,        /* Pointer for Hall value being commutated */
+        *pTableIndex;       /* Pointer for commutation table index applied */
+    
+    const uint16_t
+        *pPositionMap,      /* Pointer for Hall value to position index map */
+        *pHallValueAt,      /* Pointer for position index to Hall value map */
+        *pOverrideTable;    /* Pointer for packed commutation table */
+    
+    uint16_t
+        hallValue,          /* Hall value of the present sector */
+        floatingPhase,      /* Floating phase 0 to 2 (A to C) of the sector */
+        sign,               /* Sign of the BEMF at the start of the sector */
+        sectorTicks,        /* Control periods since the start of the sector */
+        zeroCrossTicks,     /* sectorTicks at the zero crossing, 0 if none */
+        sectorPeriod[HALL_SECTORS], /* Length of the last sectors */
+        periodIndex,        /* Next entry of sectorPeriod to write */
+        periodSum,          /* Length of the last electrical revolution */
+        lockCount,          /* Consecutive sectors with a zero crossing */
+        positionIndex,      /* Position index of the commutated sector */
+        direction,          /* 0 = increasing position index, 1 = decreasing */
+        commutationValue,   /* Hall value to commutate when active */
+        speed,              /* Speed from the sector periods when active */
+        sampleCount;        /* Incremented at every new speed value */
+    
+    uint32_t
+        speedMultiplier;    /* Speed multiplier */
+    
+    bool
+        locked,             /* Zero crossings found in the last sectors */
+        active,             /* Detector commutates the motor */
+        failure;            /* Zero crossing lost while active */
+    
+}MCAPP_BEMF_ZC_T;
+// </editor-fold>
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* BEMF_ZERO_CROSS_TYPES_H */
@@ -60,11 +60,13 @@
 
 // <editor-fold defaultstate="collapsed" desc="CONSTANTS">
 
-/* The values 0x1000,0x2000 and 0x3000 are written to the PWM PGxIOCONL register
+/* The values DC_PLUS (0x1000), DC_MINUS (0x2000) and PWM_OFF (0x3000) are 
+* written to the PWM PGxIOCONL register
 *      0x1000 corresponds to Override enable to PWMxL with override data = 0b00
 *      0x2000 corresponds to Override enable to PWMxH with override data = 0b00
 *      0x3000 corresponds to Override enable to PWMxL and PWMxH 
 *                                                     with override data = 0b00
+* Each table entry packs the states of PWM3, PWM2 and PWM1 in one word.
 * Voltage vector vs electrical angle in degrees
 * Voltage vector sequence applied to the motor :
 *                                   [ 100  ,  110 ,  010 ,  011 , 001 , 101 ]              
@@ -74,16 +76,40 @@
 */
 /* Three-phase vector (as in Space Vector Modulation) applied to the motor 
                                    to determine the hall sequence pattern */
-const uint16_t SVMvector3[6]	=	{0x2000,0x2000,0x2000,0x1000,0x1000,0x1000};
-const uint16_t SVMvector2[6]	=	{0x2000,0x1000,0x1000,0x1000,0x2000,0x2000};
-const uint16_t SVMvector1[6]	=	{0x1000,0x1000,0x2000,0x2000,0x2000,0x1000};
+const uint16_t SVMvector[6] = 
+{
+    PWM_OVERRIDE_PACK(DC_MINUS, DC_MINUS, DC_PLUS),
+    PWM_OVERRIDE_PACK(DC_MINUS, DC_PLUS,  DC_PLUS),
+    PWM_OVERRIDE_PACK(DC_MINUS, DC_PLUS,  DC_MINUS),
+    PWM_OVERRIDE_PACK(DC_PLUS,  DC_PLUS,  DC_MINUS),
+    PWM_OVERRIDE_PACK(DC_PLUS,  DC_MINUS, DC_MINUS),
+    PWM_OVERRIDE_PACK(DC_PLUS,  DC_MINUS, DC_PLUS)
+};
 
 /*  Two-phase voltage vector typically applied to the motor 
                                            for trapezoidal control  */
-const uint16_t bldcVector3[6]	=	{0x2000,0x3000,0x1000,0x1000,0x3000,0x2000};
-const uint16_t bldcVector2[6]	=	{0x1000,0x1000,0x3000,0x2000,0x2000,0x3000};
-const uint16_t bldcVector1[6]	=	{0x3000,0x2000,0x2000,0x3000,0x1000,0x1000};
+const uint16_t bldcVector[6] = 
+{
+    PWM_OVERRIDE_PACK(DC_MINUS, DC_PLUS,  PWM_OFF),
+    PWM_OVERRIDE_PACK(PWM_OFF,  DC_PLUS,  DC_MINUS),
+    PWM_OVERRIDE_PACK(DC_PLUS,  PWM_OFF,  DC_MINUS),
+    PWM_OVERRIDE_PACK(DC_PLUS,  DC_MINUS, PWM_OFF),
+    PWM_OVERRIDE_PACK(PWM_OFF,  DC_MINUS, DC_PLUS),
+    PWM_OVERRIDE_PACK(DC_MINUS, PWM_OFF,  DC_PLUS)
+};
+
+/* Voltage vector applied at each step : forward sweep, then reverse sweep 
+                                    ending again at the last forward vector */
+const uint16_t hallSeqVectorOrder[HALLSEQ_STEPS] = 
+                                            {0,1,2,3,4,5,4,3,2,1,0,5};
+
+
+// </editor-fold>
 
+// <editor-fold defaultstate="collapsed" desc="STATIC FUNCTIONS ">
+
+static bool HallSeqIdentifier_VectorSettled(MCAPP_HALLSEQ_IDENT_T*);
+static void HallSeqIdentifier_Evaluate(MCAPP_HALLSEQ_IDENT_T*);
 
 // </editor-fold>
 
@@ -102,6 +128,8 @@ const uint16_t bldcVector1[6]	=	{0x3000,0x2000,0x2000,0x3000,0x1000,0x1000};
 */
 void HallSeqIdentifier_Init(MCAPP_HALLSEQ_IDENT_T* pData, int16_t pwmPeriod)
 {
+    uint16_t i;
+    
     pData->piInputCurrent.piState.kp         = HALLSEQ_CURRENT_KP;
     pData->piInputCurrent.piState.ki         = HALLSEQ_CURRENT_KI;
     pData->piInputCurrent.piState.kc         = HALLSEQ_CURRENT_KC;
@@ -111,10 +139,24 @@ void HallSeqIdentifier_Init(MCAPP_HALLSEQ_IDENT_T* pData, int16_t pwmPeriod)
     pData->piOutputCurrent.out               = 0;
     
     pData->pwmPeriod                         = pwmPeriod;
+    pData->intervalCount                     = 0;
+    pData->step                              = 0;
+    pData->vector                            = hallSeqVectorOrder[0];
+    pData->sampleValue                       = 0;
+    pData->stableCount                       = 0;
+    
+    for(i = 0; i < HALL_STATES; i++)
+    {
+        pData->sectorPosition[i] = HALL_POSITION_INVALID;
+    }
     /* Status to state algorithm is running*/
     pData->status = 0;
     /* Flag to indicate whether the algorithm is currently running */
     pData->executionFlag = 0;
+    pData->tableRestored = 0;
+    pData->warning = 0;
+    pData->tableSavePending = 0;
+    pData->tableSaveFailed = 0;
 }
 
 /**
@@ -132,7 +174,7 @@ void HallSeqIdentifier_Init(MCAPP_HALLSEQ_IDENT_T* pData, int16_t pwmPeriod)
 */
 void HallSeqIdentifier_Execute(MCAPP_HALLSEQ_IDENT_T* pData, int16_t Ibus)
 {            
-    if(pData->vector < HALL_SECTOR)
+    if(pData->step < HALLSEQ_STEPS)
     {
         /* Current Control based on bus current feedback. For limiting 
          the current to the motor winding during the hall sequence identification*/
@@ -144,7 +186,7 @@ void HallSeqIdentifier_Execute(MCAPP_HALLSEQ_IDENT_T* pData, int16_t Ibus)
                                        &pData->piOutputCurrent.out);
         
         /* Compute duty cycle */
-        pData->dutyCycle = (int16_t) (__builtin_mulss(pData->piOutputCurrent.out,
+        pData->dutyCycle = (int16_t) (MCAPP_MulSS(pData->piOutputCurrent.out,
                                                     pData->pwmPeriod) >> 15);
 
         /* Load the duty cycle */
@@ -152,14 +194,12 @@ void HallSeqIdentifier_Execute(MCAPP_HALLSEQ_IDENT_T* pData, int16_t Ibus)
 
         /* Load the voltage vector to corresponding PWM registers of each phase 
            of three phase inverter */      
-        PWM3_OverrideEnableDataSet(SVMvector3[pData->vector]);
-        PWM2_OverrideEnableDataSet(SVMvector2[pData->vector]);
-        PWM1_OverrideEnableDataSet(SVMvector1[pData->vector]); 
+        HAL_MC1PWMOverrideCommit(SVMvector[pData->vector]);
         
         /* Increment the interval counter */
         pData->intervalCount++;  
         
-        if ( pData->intervalCount > VECTOR_COMMUTATION_INTERVAL) 
+        if (HallSeqIdentifier_VectorSettled(pData)) 
         {
             /* Reading the Hall sensor value from the input port */
             pData->hallSector = MCAPP_HallSensorRead(&pData->hallInput);
@@ -175,23 +215,45 @@ void HallSeqIdentifier_Execute(MCAPP_HALLSEQ_IDENT_T* pData, int16_t Ibus)
                 /* Failure in hall sequence detection */
                 pData->failure = 1;
             }
-            /* Loading the hall sensor values into an array for reference */
-            pData->sectorSequence[pData->hallSector] = pData->hallSector; 
             
-            /* Load the PWM override data based on the hall sequence for 
-               trapezoidal commutation. */
-            pData->ovrDataOutPWM3[pData->hallSector] = bldcVector3[pData->vector];
-            pData->ovrDataOutPWM2[pData->hallSector] = bldcVector2[pData->vector];
-            pData->ovrDataOutPWM1[pData->hallSector] = bldcVector1[pData->vector];
+            if(pData->step >= HALL_SECTOR)
+            {
+                /* Reverse sweep : kept for the consistency check */
+                pData->hallReverse[pData->vector] = pData->hallSector;
+            }
+            else
+            {
+                pData->hallForward[pData->vector] = pData->hallSector;
+                
+                if(pData->hallSector < HALL_STATES)
+                {
+                    /* Loading the hall sensor values into an array for reference */
+                    pData->sectorSequence[pData->hallSector] = pData->hallSector; 
+                    /* Rotor position of the Hall value : vector index x 60 degrees */
+                    pData->sectorPosition[pData->hallSector] = pData->vector;
+
+                    /* Load the PWM override data based on the hall sequence for 
+                       trapezoidal commutation. */
+                    pData->ovrDataOut[pData->hallSector] = bldcVector[pData->vector];
+                }
+            }
             
-            /* Increment Vector index for next voltage vector. */
-            pData->vector++; 
+            /* Next step and voltage vector of the sweep. */
+            pData->step++;
+            if(pData->step < HALLSEQ_STEPS)
+            {
+                pData->vector = hallSeqVectorOrder[pData->step];
+            }
             
             pData->intervalCount = 0;
+            pData->stableCount = 0;
         }
     }
     else
     {
+        /* Cross-check forward and reverse sweeps */
+        HallSeqIdentifier_Evaluate(pData);
+        pData->step = 0;
         pData->vector = 0;
         /* Indicates the execution is completed.  */
         pData->executionFlag = 1; 
@@ -201,3 +263,148 @@ void HallSeqIdentifier_Execute(MCAPP_HALLSEQ_IDENT_T* pData, int16_t Ibus)
 
 }
 
+/**
+* <B> Function: HallSeqIdentifier_VectorSettled(MCAPP_HALLSEQ_IDENT_T*) </B>
+*
+* @brief Function to check whether the Hall value can be read for the present
+*        voltage vector.
+*        .
+* @param Pointer to the data structure containing parameters of 
+         the hall sequence identifier. 
+* @return true when rotor has settled or the vector interval has elapsed.
+* @example
+* <CODE> HallSeqIdentifier_VectorSettled(&hallSeqIdentifier); </CODE>
+*
+*/
+static bool HallSeqIdentifier_VectorSettled(MCAPP_HALLSEQ_IDENT_T* pData)
+{
+#ifdef HALLSEQ_ADAPTIVE_DWELL
+    uint16_t hallValue, minDwell;
+    
+    hallValue = MCAPP_HallSensorRead(&pData->hallInput);
+    if(hallValue == pData->sampleValue)
+    {
+        if(pData->stableCount < UINT16_MAX)
+        {
+            pData->stableCount++;
+        }
+    }
+    else
+    {
+        pData->sampleValue = hallValue;
+        pData->stableCount = 0;
+    }
+    
+    minDwell = (pData->step == 0) ? 
+                        VECTOR_ALIGN_INTERVAL : VECTOR_MIN_DWELL_INTERVAL;
+    
+    if((pData->intervalCount >= minDwell) && 
+            (hallValue != pData->previousValue) &&
+            (pData->stableCount >= HALLSEQ_HALL_STABLE_COUNT))
+    {
+        return true;
+    }
+#endif
+    return (pData->intervalCount > VECTOR_COMMUTATION_INTERVAL);
+}
+
+/**
+* <B> Function: HallSeqIdentifier_Evaluate(MCAPP_HALLSEQ_IDENT_T*) </B>
+*
+* @brief Function to check the result of the identification sweeps :
+*        (1) Confidence : percentage of vectors giving the same Hall value in
+*            the forward and the reverse sweep. Up to HALLSEQ_MAX_MISMATCH
+*            vectors may disagree, warning is then set and the forward sweep
+*            result is used.
+*        (2) Ordering : successive Hall values must differ by one sensor only.
+*        (3) Sensor to phase mapping : vector at which each sensor rises.
+*        (4) Sensor spacing : 120 degrees when the sensors rise 2 vectors 
+*            apart, 60 degrees when they rise on successive vectors.
+*        failure is set if any check fails or the spacing is unknown.
+*        .
+* @param Pointer to the data structure containing parameters of 
+         the hall sequence identifier. 
+* @return none.
+* @example
+* <CODE> HallSeqIdentifier_Evaluate(&hallSeqIdentifier); </CODE>
+*
+*/
+static void HallSeqIdentifier_Evaluate(MCAPP_HALLSEQ_IDENT_T* pData)
+{
+    uint16_t k, previous, sensor, change, matches = 0;
+    uint16_t distance, spacing60 = 0, spacing120 = 0;
+    
+    for(k = 0; k < HALL_SECTOR; k++)
+    {
+        if(pData->hallForward[k] == pData->hallReverse[k])
+        {
+            matches++;
+        }
+        
+        /* Exactly one sensor changes between adjacent vectors */
+        previous = (k == 0) ? (HALL_SECTOR - 1) : (k - 1);
+        change = pData->hallForward[k] ^ pData->hallForward[previous];
+        if((change == 0) || ((change & (change - 1)) != 0))
+        {
+            pData->failure = 1;
+        }
+    }
+    pData->confidence = (matches * 100) / HALL_SECTOR;
+    
+    for(sensor = 0; sensor < 3; sensor++)
+    {
+        pData->sensorRiseVector[sensor] = HALL_POSITION_INVALID;
+        for(k = 0; k < HALL_SECTOR; k++)
+        {
+            previous = (k == 0) ? (HALL_SECTOR - 1) : (k - 1);
+            if(((pData->hallForward[k] >> sensor) & 1) && 
+                    (((pData->hallForward[previous] >> sensor) & 1) == 0))
+            {
+                pData->sensorRiseVector[sensor] = k;
+            }
+        }
+        if(pData->sensorRiseVector[sensor] == HALL_POSITION_INVALID)
+        {
+            pData->failure = 1;
+        }
+    }
+    
+    if(pData->failure == 0)
+    {
+        for(sensor = 0; sensor < 3; sensor++)
+        {
+            distance = (pData->sensorRiseVector[(sensor + 1) % 3] + 
+                HALL_SECTOR - pData->sensorRiseVector[sensor]) % HALL_SECTOR;
+            if((distance == 2) || (distance == 4))
+            {
+                spacing120++;
+            }
+            else if((distance == 1) || (distance == 5))
+            {
+                spacing60++;
+            }
+        }
+    }
+    if(spacing120 == 3)
+    {
+        pData->sensorSpacing = HALLSEQ_SPACING_120;
+    }
+    else if(spacing60 == 2)
+    {
+        pData->sensorSpacing = HALLSEQ_SPACING_60;
+    }
+    else
+    {
+        pData->sensorSpacing = HALLSEQ_SPACING_UNKNOWN;
+    }
+    
+    if((pData->confidence < HALLSEQ_MIN_CONFIDENCE) || 
+            (pData->sensorSpacing == HALLSEQ_SPACING_UNKNOWN))
+    {
+        pData->failure = 1;
+    }
+    else if(matches < HALL_SECTOR)
+    {
+        pData->warning = 1;
+    }
+}
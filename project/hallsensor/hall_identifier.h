@@ -75,7 +75,7 @@
 
 /** PI coefficients for current control of hall sequence identifier */        
 #define HALLSEQ_CURRENT_KP          Q15(0.8)
-#define HALLSEQ_CURRENT_KI          Q15(0.003)
+#define HALLSEQ_CURRENT_KI          LOOP_RATE_SCALED(Q15(0.003))
 #define HALLSEQ_CURRENT_KC          Q15(0.999)
 #define HALLSEQ_CURRENT_OUTMAX      Q15(0.9)
         
@@ -92,18 +92,55 @@
                 
 /* Set the Voltage VECTOR COMMUTATION INTERVAL
 * 
-* Specify the VECTOR COMMUTATION INTERVAL in terms ADC ISR cycles (counts).
+* Specify the VECTOR COMMUTATION INTERVAL in seconds; it is converted to ADC 
+* ISR cycles (counts), as the detection function is called in the ADC 
+* interrupt which occurs every PWM period (LOOPTIME_SEC).
 * This sets the interval between two different voltage vectors applied to the
 * motor to determine hall sequence of the motor.
 * This interval must be varied depending on the application and motor inertia. 
-* In this code the detection function is called in the ADC interrupt which 
-* occurs every 50 microseconds.
-* e.g. VECTOR_COMMUTATION_INTERVAL(in seconds) = 20,000 * 50 usec = 1 second
+* The counts must not exceed 65535 (1.3 seconds at 50kHz).
 */
-#define VECTOR_COMMUTATION_INTERVAL 20000 
+#define VECTOR_COMMUTATION_INTERVAL_SEC 1.0f
+#define VECTOR_COMMUTATION_INTERVAL \
+                    (uint16_t)(VECTOR_COMMUTATION_INTERVAL_SEC/LOOPTIME_SEC)
+
+/* Define HALLSEQ_ADAPTIVE_DWELL to move to the next voltage vector as soon as
+* the rotor has settled, with VECTOR_COMMUTATION_INTERVAL as timeout.
+* Undefine HALLSEQ_ADAPTIVE_DWELL to hold every vector for the full 
+* VECTOR_COMMUTATION_INTERVAL.
+* The rotor is settled when the Hall value differs from that of the previous
+* vector and has been stable for HALLSEQ_HALL_STABLE_SEC. 
+* The first vector is held at least VECTOR_ALIGN_INTERVAL as the rotor starts
+* from an unknown position, the others at least VECTOR_MIN_DWELL_INTERVAL.
+*/
+#define HALLSEQ_ADAPTIVE_DWELL
+#define VECTOR_ALIGN_INTERVAL_SEC       0.2f
+#define VECTOR_MIN_DWELL_INTERVAL_SEC   0.05f
+#define HALLSEQ_HALL_STABLE_SEC         0.02f
+#define VECTOR_ALIGN_INTERVAL       \
+                    (uint16_t)(VECTOR_ALIGN_INTERVAL_SEC/LOOPTIME_SEC)
+#define VECTOR_MIN_DWELL_INTERVAL   \
+                    (uint16_t)(VECTOR_MIN_DWELL_INTERVAL_SEC/LOOPTIME_SEC)
+#define HALLSEQ_HALL_STABLE_COUNT   \
+                    (uint16_t)(HALLSEQ_HALL_STABLE_SEC/LOOPTIME_SEC)
 
 /* Hall sectors */
 #define HALL_SECTOR 6
+
+/* Steps of the identification sweep : 
+ * HALL_SECTOR vectors forward followed by HALL_SECTOR vectors in reverse */
+#define HALLSEQ_STEPS               (2 * HALL_SECTOR)
+/* Vectors allowed to give a different Hall value in the reverse sweep (rotor
+ * stopping on a Hall boundary); tables are built from the forward sweep */
+#define HALLSEQ_MAX_MISMATCH        1
+/* Minimum percentage of vectors giving the same Hall value in both sweeps */
+#define HALLSEQ_MIN_CONFIDENCE      \
+            (((HALL_SECTOR - HALLSEQ_MAX_MISMATCH) * 100) / HALL_SECTOR)
+
+/* Hall sensor spacing detected by the identifier (electrical degrees) */
+#define HALLSEQ_SPACING_UNKNOWN     0
+#define HALLSEQ_SPACING_60          60
+#define HALLSEQ_SPACING_120         120
 // </editor-fold>
 
 // <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS ">
@@ -66,22 +66,39 @@ typedef struct
         pwmPeriod,  /* Variable for PWM period */
         dutyCycle,  /* Duty cycle */
         vector,     /* SVM vector index to fetch switching sequence */
+        step,       /* Step of the forward and reverse sweep */
         hallSector, /* Hall sector */
         presentValue,       /* Present value of Hall value */
         previousValue,      /* Previous value of Hall value */
         intervalCount,     /* Interval counter */
-        sectorSequence[7], /* Array to store the Hall sector sequence */
-        /* PWM override data obtained from the identified hall sequence for the motor */
-        ovrDataOutPWM3[7],
-        ovrDataOutPWM2[7],
-        ovrDataOutPWM1[7];        
+        sampleValue,       /* Hall value sampled in the present ADC ISR cycle */
+        stableCount,       /* Number of cycles Hall value has been stable */
+        sectorSequence[HALL_STATES], /* Array to store the Hall sector sequence */
+        sectorPosition[HALL_STATES], /* Index of the vector aligned with each Hall value */
+        /* PWM override data obtained from the identified hall sequence for 
+           the motor, PWM3 to PWM1 packed by PWM_OVERRIDE_PACK */
+        ovrDataOut[HALL_STATES],
+        hallForward[6],    /* Hall value at each vector, forward sweep */
+        hallReverse[6],    /* Hall value at each vector, reverse sweep */
+        confidence,        /* Percentage of vectors agreeing in both sweeps */
+        sensorSpacing,     /* Detected Hall sensor spacing (degrees) */
+        /* Vector index at which each Hall sensor (Hall_1, Hall_2, Hall_3)
+           rises in the forward sweep : sensor to motor phase mapping */
+        sensorRiseVector[3];
     
     bool
         status, /* status of hall sequence identifier */ 
         /* Flag to indicate whether the algorithm is currently running. */
         executionFlag,
+        tableRestored, /* Tables restored from flash, identification skipped */
+        /* Sweeps disagree within HALLSEQ_MAX_MISMATCH, forward sweep used */
+        warning,
         failure; /* to indicate failure in sequence identification */
     
+    volatile bool
+        tableSavePending, /* Tables to be saved to flash by the main loop */
+        tableSaveFailed;  /* Diagnostic : tables could not be saved to flash */
+    
     MC_PIPARMIN_T      piInputCurrent; 
     MC_PIPARMOUT_T     piOutputCurrent;
     
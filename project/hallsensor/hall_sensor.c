@@ -56,6 +56,23 @@
 #include "filter.h"
 // </editor-fold> 
 
+// <editor-fold defaultstate="collapsed" desc="STATIC FUNCTIONS ">
+
+static void MCAPP_HallCalibrationUpdate(MCAPP_HALL_CALIBRATION_T *, uint16_t,
+                                                                    uint16_t);
+static void MCAPP_HallCalibrationCompute(MCAPP_HALL_CALIBRATION_T *);
+static void MCAPP_HallSectorStartUpdate(MCAPP_HALL_CALIBRATION_T *);
+static void MCAPP_HallAngleEdge(MCAPP_HALL_SENSOR_T *, uint16_t);
+static void MCAPP_HallAngleInterpolate(MCAPP_HALL_SENSOR_T *);
+static uint16_t MCAPP_HallPhaseAdvanceCompute(MCAPP_HALL_ADVANCE_T *, uint16_t);
+static uint16_t MCAPP_HallCommutationValue(MCAPP_HALL_SENSOR_T *);
+#ifdef ENABLE_HALL_GLITCH_FILTER
+static bool MCAPP_HallEdgeRejected(MCAPP_HALL_SENSOR_T *, uint16_t, uint16_t);
+#endif
+static void MCAPP_HallSequenceCheck(MCAPP_HALL_SENSOR_T *);
+
+// </editor-fold>
+
 // <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS ">
 
 /**
@@ -73,12 +90,148 @@
 void MCAPP_HallSensorInit(MCAPP_HALL_SENSOR_T *pHallsensor)
 {
     pHallsensor->calculateSpeed.speed       = 0;
+    pHallsensor->calculateSpeed.sampleCount = 0;
     pHallsensor->calculateSpeed.period      = 0;
     pHallsensor->calculateSpeed.timerValue  = 0;
+    pHallsensor->calculateSpeed.avgPeriod   = 0;
+    pHallsensor->calculateSpeed.lastTimeStamp = 0;
+    MCAPP_RingAvgFilterInit(&pHallsensor->calculateSpeed.periodFilter);
+    MCAPP_HallEdgeBufferInit(&pHallsensor->hallEdgeBuffer);
     pHallsensor->hallChangeDetected         = 0;
     pHallsensor->value                      = 0;
     pHallsensor->presentValue               = 0;
     pHallsensor->previousValue              = 0;
+    pHallsensor->commutationValue           = 0;
+    pHallsensor->edgeCount                  = 0;
+    pHallsensor->glitchFilter.rejectCount       = 0;
+    pHallsensor->glitchFilter.shortRejected     = 0;
+    pHallsensor->glitchFilter.sequenceRejected  = 0;
+    pHallsensor->glitchFilter.recheck           = 0;
+    pHallsensor->sequenceFault                  = 0;
+    pHallsensor->sequenceCheck.lastIndex        = HALL_POSITION_INVALID;
+    pHallsensor->sequenceCheck.expectedValue    = HALL_POSITION_INVALID;
+    pHallsensor->sequenceCheck.direction        = 0;
+    pHallsensor->sequenceCheck.errorLevel       = 0;
+    pHallsensor->sequenceCheck.skipped          = 0;
+    pHallsensor->sequenceCheck.reversed         = 0;
+    pHallsensor->sequenceCheck.faultEnabled     = 0;
+    pHallsensor->phaseAdvance.advance       = 0;
+    
+    /* Learned sector widths and position map are retained */
+    pHallsensor->hallCalibration.edgeCount          = 0;
+    pHallsensor->hallCalibration.sectorsSeen        = 0;
+    pHallsensor->hallCalibration.revolutionPeriod   = 0;
+    pHallsensor->hallCalibration.lastRevolutionPeriod = 0;
+    
+    pHallsensor->hallAngle.angle            = 0;
+    pHallsensor->hallAngle.angleInSector    = 0;
+    pHallsensor->hallAngle.angleStep        = 0;
+    pHallsensor->hallAngle.sectorIndex      = HALL_POSITION_INVALID;
+    pHallsensor->hallAngle.direction        = 0;
+    pHallsensor->hallAngle.valid            = false;
+}
+
+/**
+* <B> Function: MCAPP_HallCalibrationInit(&pHallSensor) </B>
+*
+* @brief Function to load nominal sector widths and clear the Hall value to
+*        position map; until a map is loaded Hall values 1 to 6 are valid.
+*        Called once at power up, as learned widths and position map are 
+*        retained by MCAPP_HallSensorInit.
+*        
+* @param Pointer to the data structure containing hall sensor parameters.
+* @return none.
+* 
+* @example
+* <CODE> MCAPP_HallCalibrationInit(&pHallSensor); </CODE>
+*
+*/
+void MCAPP_HallCalibrationInit(MCAPP_HALL_SENSOR_T *pHallSensor)
+{
+    MCAPP_HALL_CALIBRATION_T *pCalib = &pHallSensor->hallCalibration;
+    uint16_t i;
+    
+    for(i = 0; i < HALL_STATES; i++)
+    {
+        pHallSensor->positionMap[i] = HALL_POSITION_INVALID;
+        pHallSensor->validState[i] = ((i > 0) && (i < 7));
+    }
+    for(i = 0; i < HALL_SECTORS; i++)
+    {
+        pHallSensor->hallValueAt[i] = 0;
+        pCalib->sectorWidth[i] = HALL_SECTOR_WIDTH_NOMINAL;
+        pCalib->correction[i] = HALL_CALIB_CORRECTION_ONE;
+    }
+    MCAPP_HallSectorStartUpdate(pCalib);
+    
+    pCalib->state = HALL_CALIB_IDLE;
+}
+
+/**
+* <B> Function: MCAPP_HallCalibrationStart(&pHallSensor) </B>
+*
+* @brief Function to start learning the sector widths. Learning progresses in
+*        MCAPP_MeasureSpeed whenever the motor runs at constant speed.
+*        
+* @param Pointer to the data structure containing hall sensor parameters.
+* @return none.
+* 
+* @example
+* <CODE> MCAPP_HallCalibrationStart(&pHallSensor); </CODE>
+*
+*/
+void MCAPP_HallCalibrationStart(MCAPP_HALL_SENSOR_T *pHallSensor)
+{
+    MCAPP_HALL_CALIBRATION_T *pCalib = &pHallSensor->hallCalibration;
+    uint16_t i;
+    
+    for(i = 0; i < HALL_SECTORS; i++)
+    {
+        pCalib->sectorPeriodSum[i] = 0;
+    }
+    pCalib->totalPeriod = 0;
+    pCalib->revolutionCount = 0;
+    pCalib->edgeCount = 0;
+    pCalib->sectorsSeen = 0;
+    pCalib->revolutionPeriod = 0;
+    pCalib->lastRevolutionPeriod = 0;
+    
+    pCalib->state = HALL_CALIB_RUNNING;
+}
+
+/**
+* <B> Function: MCAPP_HallPositionMapLoad(&pHallSensor, pMap) </B>
+*
+* @brief Function to load the position index (0 to 5) of each Hall value, as
+*        found by the hall sequence identifier, and start the sector width
+*        calibration.
+*        
+* @param Pointer to the data structure containing hall sensor parameters.
+* @param Position index of Hall values 0 to 7, HALL_POSITION_INVALID if the
+*        Hall value is not part of the sequence. The map also defines the valid
+*        Hall values.
+* @return none.
+* 
+* @example
+* <CODE> MCAPP_HallPositionMapLoad(&pHallSensor, pMap); </CODE>
+*
+*/
+void MCAPP_HallPositionMapLoad(MCAPP_HALL_SENSOR_T *pHallSensor,
+                                                        const uint16_t *pMap)
+{
+    uint16_t i;
+    
+    for(i = 0; i < HALL_STATES; i++)
+    {
+        pHallSensor->positionMap[i] = pMap[i];
+        pHallSensor->validState[i] = (pMap[i] < HALL_SECTORS);
+        if(pMap[i] < HALL_SECTORS)
+        {
+            pHallSensor->hallValueAt[pMap[i]] = i;
+        }
+    }
+    
+    MCAPP_HallCalibrationStart(pHallSensor);
 }
 
 /**
@@ -149,6 +302,8 @@ void MCAPP_HallSensorValue(MCAPP_HALL_SENSOR_T *pHallSensor)
 * <B> Function: MCAPP_MeasureSpeed(&pHallSensor) </B>
 *
 * @brief Function to calculate speed using hall sensor feedback.
+*        Period only changes on a Hall edge, hence filter and division are
+*        executed only for the edges queued by HallSensorHandler.
 *        
 * @param none.
 * @return none.
@@ -160,24 +315,99 @@ void MCAPP_HallSensorValue(MCAPP_HALL_SENSOR_T *pHallSensor)
 void MCAPP_MeasureSpeed(MCAPP_HALL_SENSOR_T *pHallSensor)
 {   
     MCAPP_CALC_SPEED_T *pCalculateSpeed = &pHallSensor->calculateSpeed;
+    MCAPP_HALL_ANGLE_T *pAngle = &pHallSensor->hallAngle;
+    MCAPP_HALL_EDGE_T hallEdge;
+    uint32_t edgePeriod;
+    bool newPeriod = false;
+    
+    while(MCAPP_HallEdgeBufferRead(&pHallSensor->hallEdgeBuffer, &hallEdge))
+    {
+        edgePeriod = hallEdge.timeStamp - pCalculateSpeed->lastTimeStamp;
+        pCalculateSpeed->lastTimeStamp = hallEdge.timeStamp;
+        if(edgePeriod > UINT16_MAX)
+        {
+            edgePeriod = UINT16_MAX;
+        }
+        
+        /* Period belongs to the sector the rotor has just left */
+        if(pAngle->sectorIndex < HALL_SECTORS)
+        {
+            MCAPP_HallCalibrationUpdate(&pHallSensor->hallCalibration,
+                                pAngle->sectorIndex, (uint16_t)edgePeriod);
+            
+            /* Scale period to that of a nominal 60 degree sector */
+            edgePeriod = MCAPP_MulUU((uint16_t)edgePeriod, 
+                pHallSensor->hallCalibration.correction[pAngle->sectorIndex])
+                                                                        >> 14;
+            if(edgePeriod > UINT16_MAX)
+            {
+                edgePeriod = UINT16_MAX;
+            }
+        }
+        
+        /* Calculating Moving Average of Period over complete electrical 
+           revolutions, so that Hall sector width errors cancel out */
+        pCalculateSpeed->avgPeriod = 
+                MCAPP_RingAvgFilter(&pCalculateSpeed->periodFilter,
+                                    (uint16_t)edgePeriod);
+        
+        MCAPP_HallAngleEdge(pHallSensor, hallEdge.hallValue);
+        newPeriod = true;
+    }
     
-    /* Calculating Moving Average of Period */
-    pCalculateSpeed->avgPeriod = MCAPP_MovingAvgFilter(pCalculateSpeed->period);
     /* Calculating Speed using the period*/
-    if(pCalculateSpeed->avgPeriod != 0)
+    if((newPeriod == true) && (pCalculateSpeed->avgPeriod != 0))
     {
-        pCalculateSpeed->speed = __builtin_divud(pCalculateSpeed->multiplier,pCalculateSpeed->avgPeriod);
+        pCalculateSpeed->speed = MCAPP_DivUD(pCalculateSpeed->multiplier,pCalculateSpeed->avgPeriod);
+        pCalculateSpeed->sampleCount++;
+        
+        /* Angle travelled per control period */
+        if(pCalculateSpeed->avgPeriod > (pAngle->stepMultiplier >> 16))
+        {
+            pAngle->angleStep = MCAPP_DivUD(pAngle->stepMultiplier,
+                                            pCalculateSpeed->avgPeriod);
+        }
+        else
+        {
+            pAngle->angleStep = UINT16_MAX;
+        }
+        
+        pHallSensor->phaseAdvance.advance = MCAPP_HallPhaseAdvanceCompute(
+                &pHallSensor->phaseAdvance, pCalculateSpeed->speed);
     }
+    
+    MCAPP_HallAngleInterpolate(pHallSensor);
+    
+    pHallSensor->commutationValue = MCAPP_HallCommutationValue(pHallSensor);
 }
 
 void HallSensorHandler(MCAPP_HALL_SENSOR_T *pHallSensor)
 {
     MCAPP_CALC_SPEED_T *pCalculateSpeed = &pHallSensor->calculateSpeed;
+#ifdef ENABLE_HALL_GLITCH_FILTER
+    uint16_t acceptedValue = pHallSensor->value;
+#endif
     
     /* Starting the timer*/
     HallStateChangeTimerStart();
     /* Update the Hall pattern */
     MCAPP_HallSensorValue(pHallSensor);
+#ifdef ENABLE_HALL_GLITCH_FILTER
+    pHallSensor->glitchFilter.recheck = 0;
+    if((pHallSensor->hallChangeDetected == 1) &&
+            MCAPP_HallEdgeRejected(pHallSensor, acceptedValue, 
+                                            HallStateChangeTimerDataRead()))
+    {
+        /* Keep the last accepted Hall value; the SCCP timer is not cleared 
+           so that the next edge is timed from the last accepted one */
+        pHallSensor->value = acceptedValue;
+        pHallSensor->previousValue = acceptedValue;
+        pHallSensor->hallChangeDetected = 0;
+        /* No CN interrupt follows unless the inputs change again : read 
+           them again from the control interrupt */
+        pHallSensor->glitchFilter.recheck = 1;
+    }
+#endif
     /* 
      * Check if the Hall change is detected to avoid spurious 
        change notification interrupts are detected.
@@ -190,6 +420,9 @@ void HallSensorHandler(MCAPP_HALL_SENSOR_T *pHallSensor)
         HallStateChangeTimerDataSet(0);
         /* Buffer for Period */
         pCalculateSpeed->period =  pCalculateSpeed->timerValue;
+        /* Queue the edge; speed is updated in next MCAPP_MeasureSpeed call */
+        MCAPP_HallEdgeBufferWrite(&pHallSensor->hallEdgeBuffer,
+                            pHallSensor->value, pCalculateSpeed->timerValue);
         
         /* Incorrect timer value */
         if(pCalculateSpeed->timerValue == 0)
@@ -197,11 +430,13 @@ void HallSensorHandler(MCAPP_HALL_SENSOR_T *pHallSensor)
             pHallSensor->timerError = 1;
         }
         /*  Hall malfunction detection: check if the hall state is 
-          0 or 7 and enable Hall failure flag */
-        if((pHallSensor->value > 0)&&(pHallSensor->value < 7))
+          part of the identified sequence, else enable Hall failure flag */
+        if(pHallSensor->validState[pHallSensor->value & (HALL_STATES - 1)])
         {
             pHallSensor->hallFailure = 0;
             pHallSensor->sector = pHallSensor->value ;
+            pHallSensor->edgeCount++;
+            MCAPP_HallSequenceCheck(pHallSensor);
         }
         else
         {
@@ -213,4 +448,686 @@ void HallSensorHandler(MCAPP_HALL_SENSOR_T *pHallSensor)
         /* Hall Change detection flag is cleared */
         pHallSensor->hallChangeDetected = 0;
     }
-}
\ No newline at end of file
+}
+
+/**
+* <B> Function: MCAPP_HallGlitchRecheck(&pHallSensor) </B>
+*
+* @brief Function to read the Hall inputs again after the glitch filter 
+*        rejected an edge. A CN interrupt follows only the next change of the
+*        inputs : a real edge rejected by the filter would otherwise leave 
+*        the previous sector applied until the next Hall edge. Called from 
+*        the control interrupt, which has the priority of the CN interrupt.
+*        
+* @param Pointer to the data structure containing hall sensor parameters.
+* @return none.
+* 
+* @example
+* <CODE> MCAPP_HallGlitchRecheck(&pHallSensor); </CODE>
+*
+*/
+void MCAPP_HallGlitchRecheck(MCAPP_HALL_SENSOR_T *pHallSensor)
+{
+#ifdef ENABLE_HALL_GLITCH_FILTER
+    if(pHallSensor->glitchFilter.recheck == 1)
+    {
+        HallSensorHandler(pHallSensor);
+    }
+#endif
+}
+
+/**
+* <B> Function: MCAPP_HallEdgeBufferInit(&pBuffer) </B>
+*
+* @brief Function to empty the Hall edge buffer.
+*        
+* @param Pointer to the Hall edge buffer.
+* @return none.
+* 
+* @example
+* <CODE> MCAPP_HallEdgeBufferInit(&pBuffer); </CODE>
+*
+*/
+void MCAPP_HallEdgeBufferInit(MCAPP_HALL_EDGE_BUFFER_T *pBuffer)
+{
+    pBuffer->head = 0;
+    pBuffer->tail = 0;
+    pBuffer->overrun = 0;
+    pBuffer->timeStamp = 0;
+}
+
+/**
+* <B> Function: MCAPP_HallEdgeBufferWrite(&pBuffer, hallValue, period) </B>
+*
+* @brief Function to queue a Hall edge. Called only by the producer
+*        (Hall change notification interrupt). The time stamp is built by
+*        accumulating the SCCP timer value, which is cleared on every edge.
+*        When the buffer is full the edge is dropped and counted as overrun;
+*        its period is not accumulated, so that the period of the next queued
+*        edge still spans a single sector.
+*        
+* @param Pointer to the Hall edge buffer.
+* @param Hall value after the edge.
+* @param SCCP timer value since the previous edge.
+* @return none.
+* 
+* @example
+* <CODE> MCAPP_HallEdgeBufferWrite(&pBuffer, hallValue, period); </CODE>
+*
+*/
+void MCAPP_HallEdgeBufferWrite(MCAPP_HALL_EDGE_BUFFER_T *pBuffer,
+                                    uint16_t hallValue, uint32_t period)
+{
+    uint16_t head = pBuffer->head;
+    uint16_t nextHead = (head + 1) & HALL_EDGE_BUFFER_MASK;
+    
+    if(nextHead == pBuffer->tail)
+    {
+        pBuffer->overrun++;
+    }
+    else
+    {
+        pBuffer->timeStamp += period;
+        pBuffer->edge[head].hallValue = hallValue;
+        pBuffer->edge[head].timeStamp = pBuffer->timeStamp;
+        /* Publish the record only after it is completely written */
+        pBuffer->head = nextHead;
+    }
+}
+
+/**
+* <B> Function: MCAPP_HallEdgeBufferRead(&pBuffer, &pEdge) </B>
+*
+* @brief Function to read the oldest queued Hall edge. Called only by the
+*        consumer.
+*        
+* @param Pointer to the Hall edge buffer.
+* @param Pointer to the record receiving the Hall edge.
+* @return true if a Hall edge was read, false if the buffer is empty.
+* 
+* @example
+* <CODE> MCAPP_HallEdgeBufferRead(&pBuffer, &pEdge); </CODE>
+*
+*/
+bool MCAPP_HallEdgeBufferRead(MCAPP_HALL_EDGE_BUFFER_T *pBuffer,
+                                    MCAPP_HALL_EDGE_T *pEdge)
+{
+    uint16_t tail = pBuffer->tail;
+    
+    if(tail == pBuffer->head)
+    {
+        return false;
+    }
+    
+    *pEdge = pBuffer->edge[tail];
+    /* Release the record only after it is completely read */
+    pBuffer->tail = (tail + 1) & HALL_EDGE_BUFFER_MASK;
+    
+    return true;
+}
+
+/**
+* <B> Function: MCAPP_HallCalibrationUpdate(&pCalib, sectorIndex, period) </B>
+*
+* @brief Function to accumulate the period of a Hall sector. Periods of a
+*        revolution are accumulated only if the revolution period is close to
+*        that of the previous revolution, otherwise learning restarts.
+*        
+* @param Pointer to the data structure containing calibration parameters.
+* @param Position index of the sector the rotor has left.
+* @param Time spent in the sector.
+* @return none.
+* 
+* @example
+* <CODE> MCAPP_HallCalibrationUpdate(&pCalib, sectorIndex, period); </CODE>
+*
+*/
+static void MCAPP_HallCalibrationUpdate(MCAPP_HALL_CALIBRATION_T *pCalib,
+                                        uint16_t sectorIndex, uint16_t period)
+{
+    uint32_t deviation;
+    uint16_t i;
+    
+    if(pCalib->state != HALL_CALIB_RUNNING)
+    {
+        return;
+    }
+    
+    /* A sector seen twice (direction reversal, missed edge) spoils the
+       present revolution */
+    if(pCalib->sectorsSeen & (1 << sectorIndex))
+    {
+        pCalib->edgeCount = 0;
+        pCalib->sectorsSeen = 0;
+        pCalib->revolutionPeriod = 0;
+        pCalib->lastRevolutionPeriod = 0;
+    }
+    
+    pCalib->revolutionSectorPeriod[sectorIndex] = period;
+    pCalib->sectorsSeen |= (1 << sectorIndex);
+    pCalib->revolutionPeriod += period;
+    pCalib->edgeCount++;
+    
+    if(pCalib->edgeCount < HALL_SECTORS)
+    {
+        return;
+    }
+    
+    if(pCalib->revolutionPeriod > pCalib->lastRevolutionPeriod)
+    {
+        deviation = pCalib->revolutionPeriod - pCalib->lastRevolutionPeriod;
+    }
+    else
+    {
+        deviation = pCalib->lastRevolutionPeriod - pCalib->revolutionPeriod;
+    }
+    
+    if(deviation <= 
+            (pCalib->lastRevolutionPeriod >> HALL_CALIB_STABILITY_SHIFT))
+    {
+        for(i = 0; i < HALL_SECTORS; i++)
+        {
+            pCalib->sectorPeriodSum[i] += pCalib->revolutionSectorPeriod[i];
+        }
+        pCalib->totalPeriod += pCalib->revolutionPeriod;
+        pCalib->revolutionCount++;
+    }
+    else
+    {
+        /* Speed is changing : discard what has been accumulated */
+        for(i = 0; i < HALL_SECTORS; i++)
+        {
+            pCalib->sectorPeriodSum[i] = 0;
+        }
+        pCalib->totalPeriod = 0;
+        pCalib->revolutionCount = 0;
+    }
+    
+    pCalib->lastRevolutionPeriod = pCalib->revolutionPeriod;
+    pCalib->revolutionPeriod = 0;
+    pCalib->edgeCount = 0;
+    pCalib->sectorsSeen = 0;
+    
+    if(pCalib->revolutionCount >= HALL_CALIB_REVOLUTIONS)
+    {
+        MCAPP_HallCalibrationCompute(pCalib);
+    }
+}
+
+/**
+* <B> Function: MCAPP_HallCalibrationCompute(&pCalib) </B>
+*
+* @brief Function to compute sector widths and correction factors from the
+*        accumulated sector periods.
+*        
+* @param Pointer to the data structure containing calibration parameters.
+* @return none.
+* 
+* @example
+* <CODE> MCAPP_HallCalibrationCompute(&pCalib); </CODE>
+*
+*/
+static void MCAPP_HallCalibrationCompute(MCAPP_HALL_CALIBRATION_T *pCalib)
+{
+    uint16_t width[HALL_SECTORS];
+    uint16_t i, shift = 0;
+    
+    /* Scale total period to 16 bits for the divide; 
+       width = sectorPeriodSum * 65536 / totalPeriod */
+    while((pCalib->totalPeriod >> shift) > UINT16_MAX)
+    {
+        shift++;
+    }
+    
+    for(i = 0; i < HALL_SECTORS; i++)
+    {
+        width[i] = MCAPP_DivUD(pCalib->sectorPeriodSum[i] << (16 - shift),
+                                (uint16_t)(pCalib->totalPeriod >> shift));
+        if((width[i] < HALL_CALIB_WIDTH_MIN) || 
+                                            (width[i] > HALL_CALIB_WIDTH_MAX))
+        {
+            pCalib->state = HALL_CALIB_FAILED;
+            return;
+        }
+    }
+    
+    for(i = 0; i < HALL_SECTORS; i++)
+    {
+        pCalib->sectorWidth[i] = width[i];
+        pCalib->correction[i] = 
+                MCAPP_DivUD((uint32_t)HALL_SECTOR_WIDTH_NOMINAL << 14, width[i]);
+    }
+    MCAPP_HallSectorStartUpdate(pCalib);
+    
+    pCalib->state = HALL_CALIB_DONE;
+}
+
+/**
+* <B> Function: MCAPP_HallSectorStartUpdate(&pCalib) </B>
+*
+* @brief Function to compute the angle at the start of each sector. Angle 0 is
+*        the centre of position 0, where the rotor aligns with the first
+*        voltage vector applied by the hall sequence identifier.
+*        
+* @param Pointer to the data structure containing calibration parameters.
+* @return none.
+* 
+* @example
+* <CODE> MCAPP_HallSectorStartUpdate(&pCalib); </CODE>
+*
+*/
+static void MCAPP_HallSectorStartUpdate(MCAPP_HALL_CALIBRATION_T *pCalib)
+{
+    uint16_t i;
+    
+    pCalib->sectorStart[0] = (uint16_t)(0 - (pCalib->sectorWidth[0] >> 1));
+    for(i = 1; i < HALL_SECTORS; i++)
+    {
+        pCalib->sectorStart[i] = 
+                pCalib->sectorStart[i - 1] + pCalib->sectorWidth[i - 1];
+    }
+}
+
+/**
+* <B> Function: MCAPP_HallAngleEdge(&pHallSensor, hallValue) </B>
+*
+* @brief Function to resynchronise the interpolated angle on a Hall edge.
+*        The direction of rotation is taken from the order of positions.
+*        
+* @param Pointer to the data structure containing hall sensor parameters.
+* @param Hall value after the edge.
+* @return none.
+* 
+* @example
+* <CODE> MCAPP_HallAngleEdge(&pHallSensor, hallValue); </CODE>
+*
+*/
+static void MCAPP_HallAngleEdge(MCAPP_HALL_SENSOR_T *pHallSensor,
+                                                            uint16_t hallValue)
+{
+    MCAPP_HALL_ANGLE_T *pAngle = &pHallSensor->hallAngle;
+    uint16_t sectorIndex, previousIndex;
+    
+    if(hallValue >= HALL_STATES)
+    {
+        sectorIndex = HALL_POSITION_INVALID;
+    }
+    else
+    {
+        sectorIndex = pHallSensor->positionMap[hallValue];
+    }
+    previousIndex = pAngle->sectorIndex;
+    pAngle->sectorIndex = sectorIndex;
+    
+    if((sectorIndex >= HALL_SECTORS) || (previousIndex >= HALL_SECTORS))
+    {
+        pAngle->valid = false;
+    }
+    else if(sectorIndex == ((previousIndex == (HALL_SECTORS - 1)) ? 
+                                                    0 : (previousIndex + 1)))
+    {
+        pAngle->direction = 0;
+        pAngle->valid = true;
+    }
+    else if(previousIndex == ((sectorIndex == (HALL_SECTORS - 1)) ? 
+                                                    0 : (sectorIndex + 1)))
+    {
+        pAngle->direction = 1;
+        pAngle->valid = true;
+    }
+    else
+    {
+        pAngle->valid = false;
+    }
+    
+    if((pAngle->valid == true) && (pAngle->direction == 1))
+    {
+        /* Entering the sector at its end */
+        pAngle->angleInSector = 
+                pHallSensor->hallCalibration.sectorWidth[sectorIndex];
+    }
+    else
+    {
+        pAngle->angleInSector = 0;
+    }
+}
+
+/**
+* <B> Function: MCAPP_HallAngleInterpolate(&pHallSensor) </B>
+*
+* @brief Function to advance the rotor angle by one control period. The angle
+*        is held at the sector boundary until the next Hall edge arrives.
+*        Until the direction is known the angle is the centre of the sector.
+*        
+* @param Pointer to the data structure containing hall sensor parameters.
+* @return none.
+* 
+* @example
+* <CODE> MCAPP_HallAngleInterpolate(&pHallSensor); </CODE>
+*
+*/
+static void MCAPP_HallAngleInterpolate(MCAPP_HALL_SENSOR_T *pHallSensor)
+{
+    MCAPP_HALL_ANGLE_T *pAngle = &pHallSensor->hallAngle;
+    MCAPP_HALL_CALIBRATION_T *pCalib = &pHallSensor->hallCalibration;
+    uint16_t width;
+    
+    if(pAngle->sectorIndex >= HALL_SECTORS)
+    {
+        return;
+    }
+    
+    width = pCalib->sectorWidth[pAngle->sectorIndex];
+    
+    if(pAngle->valid == false)
+    {
+        pAngle->angleInSector = width >> 1;
+    }
+    else if(pAngle->direction == 0)
+    {
+        if((uint16_t)(width - pAngle->angleInSector) > pAngle->angleStep)
+        {
+            pAngle->angleInSector += pAngle->angleStep;
+        }
+        else
+        {
+            pAngle->angleInSector = width;
+        }
+    }
+    else
+    {
+        if(pAngle->angleInSector > pAngle->angleStep)
+        {
+            pAngle->angleInSector -= pAngle->angleStep;
+        }
+        else
+        {
+            pAngle->angleInSector = 0;
+        }
+    }
+    
+    pAngle->angle = pCalib->sectorStart[pAngle->sectorIndex] + 
+                                                        pAngle->angleInSector;
+}
+
+/**
+* <B> Function: MCAPP_HallPhaseAdvanceCompute(&pAdvance, speed) </B>
+*
+* @brief Function to compute the commutation phase advance from speed.
+*        Advance rises linearly above startSpeed and is limited to maxAdvance.
+*        
+* @param Pointer to the data structure containing phase advance parameters.
+* @param Measured speed.
+* @return Phase advance, 65536 = 360 degrees.
+* 
+* @example
+* <CODE> MCAPP_HallPhaseAdvanceCompute(&pAdvance, speed); </CODE>
+*
+*/
+static uint16_t MCAPP_HallPhaseAdvanceCompute(MCAPP_HALL_ADVANCE_T *pAdvance,
+                                                                uint16_t speed)
+{
+    uint32_t advance;
+    
+    if(speed <= pAdvance->startSpeed)
+    {
+        return 0;
+    }
+    
+    advance = MCAPP_MulUU(speed - pAdvance->startSpeed, pAdvance->gain) 
+                                                    >> PHASE_ADVANCE_GAIN_SHIFT;
+    if(advance > pAdvance->maxAdvance)
+    {
+        advance = pAdvance->maxAdvance;
+    }
+    
+    return (uint16_t)advance;
+}
+
+/**
+* <B> Function: MCAPP_HallCommutationValue(&pHallSensor) </B>
+*
+* @brief Function to select the Hall value used for commutation. When the
+*        interpolated angle is within the phase advance of the end of the
+*        present sector, the Hall value of the next sector in the direction of
+*        rotation is returned, so that the inverter commutates ahead of the
+*        Hall edge. Otherwise the present Hall value is returned.
+*        
+* @param Pointer to the data structure containing hall sensor parameters.
+* @return Hall value to commutate.
+* 
+* @example
+* <CODE> MCAPP_HallCommutationValue(&pHallSensor); </CODE>
+*
+*/
+static uint16_t MCAPP_HallCommutationValue(MCAPP_HALL_SENSOR_T *pHallSensor)
+{
+    MCAPP_HALL_ANGLE_T *pAngle = &pHallSensor->hallAngle;
+    uint16_t advance = pHallSensor->phaseAdvance.advance;
+    uint16_t width, nextIndex;
+    
+    if((advance == 0) || (pAngle->valid == false))
+    {
+        return pHallSensor->value;
+    }
+    
+    width = pHallSensor->hallCalibration.sectorWidth[pAngle->sectorIndex];
+    
+    if(pAngle->direction == 0)
+    {
+        if((uint16_t)(width - pAngle->angleInSector) > advance)
+        {
+            return pHallSensor->value;
+        }
+        nextIndex = (pAngle->sectorIndex == (HALL_SECTORS - 1)) ? 
+                                                0 : (pAngle->sectorIndex + 1);
+    }
+    else
+    {
+        if(pAngle->angleInSector > advance)
+        {
+            return pHallSensor->value;
+        }
+        nextIndex = (pAngle->sectorIndex == 0) ? 
+                                (HALL_SECTORS - 1) : (pAngle->sectorIndex - 1);
+    }
+    
+    return pHallSensor->hallValueAt[nextIndex];
+}
+
+/**
+* <B> Function: MCAPP_HallSequenceCheckStart(&pHallSensor) </B>
+*
+* @brief Function to restart the sector sequence check when the motor is 
+*        started : errors seen while the outputs were off are cleared and
+*        the sequence fault is enabled. The direction of rotation is kept.
+*        
+* @param Pointer to the data structure containing hall sensor parameters.
+* @return none.
+* 
+* @example
+* <CODE> MCAPP_HallSequenceCheckStart(&pHallSensor); </CODE>
+*
+*/
+void MCAPP_HallSequenceCheckStart(MCAPP_HALL_SENSOR_T *pHallSensor)
+{
+    MCAPP_HALL_SEQUENCE_CHECK_T *pCheck = &pHallSensor->sequenceCheck;
+    
+    pCheck->errorLevel = 0;
+    pCheck->lastIndex = HALL_POSITION_INVALID;
+    pCheck->expectedValue = HALL_POSITION_INVALID;
+    pHallSensor->sequenceFault = 0;
+    pCheck->faultEnabled = 1;
+}
+
+/**
+* <B> Function: MCAPP_HallSequenceCheckStop(&pHallSensor) </B>
+*
+* @brief Function to disable the sequence fault when the PWM outputs are 
+*        disabled. Transitions are still tracked for the direction of 
+*        rotation.
+*        
+* @param Pointer to the data structure containing hall sensor parameters.
+* @return none.
+* 
+* @example
+* <CODE> MCAPP_HallSequenceCheckStop(&pHallSensor); </CODE>
+*
+*/
+void MCAPP_HallSequenceCheckStop(MCAPP_HALL_SENSOR_T *pHallSensor)
+{
+    pHallSensor->sequenceCheck.faultEnabled = 0;
+    pHallSensor->sequenceFault = 0;
+}
+
+/**
+* <B> Function: MCAPP_HallSequenceCheck(&pHallSensor) </B>
+*
+* @brief Function to compare a new valid Hall value with the value predicted
+*        from the identified sequence and the direction of rotation. A 
+*        transition against the direction (the direction is then reversed)
+*        or skipping sectors raises the error level; a predicted transition
+*        lowers it. sequenceFault is set when the error level reaches
+*        HALL_SEQUENCE_FAULT_LEVEL while faultEnabled is set.
+*        
+* @param Pointer to the data structure containing hall sensor parameters.
+* @return none.
+* 
+* @example
+* <CODE> MCAPP_HallSequenceCheck(&pHallSensor); </CODE>
+*
+*/
+static void MCAPP_HallSequenceCheck(MCAPP_HALL_SENSOR_T *pHallSensor)
+{
+    MCAPP_HALL_SEQUENCE_CHECK_T *pCheck = &pHallSensor->sequenceCheck;
+    uint16_t index, distance, nextIndex;
+    
+    index = pHallSensor->positionMap[pHallSensor->value & (HALL_STATES - 1)];
+    if(index >= HALL_SECTORS)
+    {
+        return;
+    }
+    
+    if(pCheck->lastIndex < HALL_SECTORS)
+    {
+        distance = (index + HALL_SECTORS - pCheck->lastIndex) % HALL_SECTORS;
+        if(pCheck->expectedValue == HALL_POSITION_INVALID)
+        {
+            /* First transition : sets the direction of rotation */
+            pCheck->direction = (distance == (HALL_SECTORS - 1)) ? 1 : 0;
+        }
+        else if(pHallSensor->value == pCheck->expectedValue)
+        {
+            if(pCheck->errorLevel > 0)
+            {
+                pCheck->errorLevel--;
+            }
+        }
+        else
+        {
+            if(distance == (uint16_t)(pCheck->direction ? 1 : (HALL_SECTORS - 1)))
+            {
+                pCheck->reversed++;
+                pCheck->direction ^= 1;
+            }
+            else
+            {
+                pCheck->skipped++;
+            }
+            pCheck->errorLevel += HALL_SEQUENCE_ERROR_WEIGHT;
+            if(pCheck->errorLevel >= HALL_SEQUENCE_FAULT_LEVEL)
+            {
+                pCheck->errorLevel = HALL_SEQUENCE_FAULT_LEVEL;
+                if(pCheck->faultEnabled == 1)
+                {
+                    pHallSensor->sequenceFault = 1;
+                }
+            }
+        }
+        
+        /* Predict the next Hall value */
+        if(pCheck->direction == 0)
+        {
+            nextIndex = (index == (HALL_SECTORS - 1)) ? 0 : (index + 1);
+        }
+        else
+        {
+            nextIndex = (index == 0) ? (HALL_SECTORS - 1) : (index - 1);
+        }
+        pCheck->expectedValue = pHallSensor->hallValueAt[nextIndex];
+    }
+    pCheck->lastIndex = index;
+}
+
+#ifdef ENABLE_HALL_GLITCH_FILTER
+/**
+* <B> Function: MCAPP_HallEdgeRejected(&pHallSensor, uint16_t, uint16_t) </B>
+*
+* @brief Function to check a Hall edge for noise. The edge is rejected when
+*        (1) its period is shorter than glitchFilter.minPeriod or a quarter of
+*            the average sector period, or
+*        (2) the new Hall value is not in a sector adjacent to that of the
+*            last accepted value in the identified sequence (checked once the
+*            position map is loaded).
+*        Hall values that are not part of the identified sequence are never
+*        rejected, so that a Hall failure is detected on the first edge.
+*        After HALL_GLITCH_MAX_REJECTS consecutive rejections (CN edges or 
+*        control interrupt rechecks) the edge is accepted, so that a real 
+*        change of Hall value is never ignored.
+*        
+* @param Pointer to the data structure containing hall sensor parameters.
+* @param Last accepted Hall value.
+* @param SCCP timer count since the last accepted edge.
+* @return true if the edge is rejected.
+* 
+* @example
+* <CODE> MCAPP_HallEdgeRejected(&pHallSensor, acceptedValue, period); </CODE>
+*
+*/
+static bool MCAPP_HallEdgeRejected(MCAPP_HALL_SENSOR_T *pHallSensor,
+                                    uint16_t acceptedValue, uint16_t period)
+{
+    MCAPP_HALL_GLITCH_FILTER_T *pFilter = &pHallSensor->glitchFilter;
+    uint16_t minPeriod, previousIndex, index, distance;
+    bool rejected = false;
+    
+    if(pHallSensor->validState[pHallSensor->value & (HALL_STATES - 1)] == 0)
+    {
+        /* Invalid Hall value : passed to the Hall failure detection */
+        pFilter->rejectCount = 0;
+        return false;
+    }
+    
+    minPeriod = pHallSensor->calculateSpeed.avgPeriod >> HALL_GLITCH_PERIOD_SHIFT;
+    if(minPeriod < pFilter->minPeriod)
+    {
+        minPeriod = pFilter->minPeriod;
+    }
+    
+    previousIndex = pHallSensor->positionMap[acceptedValue & (HALL_STATES - 1)];
+    index = pHallSensor->positionMap[pHallSensor->value & (HALL_STATES - 1)];
+    
+    if(period < minPeriod)
+    {
+        pFilter->shortRejected++;
+        rejected = true;
+    }
+    else if((previousIndex < HALL_SECTORS) && (index < HALL_SECTORS))
+    {
+        distance = (index + HALL_SECTORS - previousIndex) % HALL_SECTORS;
+        if((distance != 1) && (distance != (HALL_SECTORS - 1)))
+        {
+            pFilter->sequenceRejected++;
+            rejected = true;
+        }
+    }
+    
+    if((rejected == false) || (pFilter->rejectCount >= HALL_GLITCH_MAX_REJECTS))
+    {
+        pFilter->rejectCount = 0;
+        return false;
+    }
+    pFilter->rejectCount++;
+    return true;
+}
+#endif
@@ -79,6 +79,36 @@ extern "C" {
 #define HallStateChangeTimerDataSet           SCCP1_TimerDataSet
 #define HallStateChangeTimerDataRead          SCCP1_TimerDataRead    
 #define HallStateChangeTimerStart             SCCP1_Timer_Start  
+
+/* Number of stable electrical revolutions used to learn the sector widths */
+#define HALL_CALIB_REVOLUTIONS              16
+/* Revolution is stable when its period differs from the previous revolution
+ * by less than 1/2^HALL_CALIB_STABILITY_SHIFT */
+#define HALL_CALIB_STABILITY_SHIFT          4
+/* Allowed range of a learned sector width : 30 to 90 degrees electrical */
+#define HALL_CALIB_WIDTH_MIN                (HALL_SECTOR_WIDTH_NOMINAL >> 1)
+#define HALL_CALIB_WIDTH_MAX                (HALL_SECTOR_WIDTH_NOMINAL + \
+                                            (HALL_SECTOR_WIDTH_NOMINAL >> 1))
+/* Correction factor of a nominal width sector : 1.0 in Q14 */
+#define HALL_CALIB_CORRECTION_ONE           (1 << 14)
+
+/* Glitch filter : an edge is too short when its period is less than 
+ * avgPeriod >> HALL_GLITCH_PERIOD_SHIFT (a quarter of the average) */
+#define HALL_GLITCH_PERIOD_SHIFT            2
+/* Consecutive rejected edges after which the Hall value is accepted anyway,
+ * so that the filter cannot hold a wrong sector indefinitely */
+#define HALL_GLITCH_MAX_REJECTS             3
+
+/* Sector sequence check : every skipped or reversed transition adds 
+ * HALL_SEQUENCE_ERROR_WEIGHT to the error level, every predicted transition
+ * removes 1. The sequence fault is set when the level reaches 
+ * HALL_SEQUENCE_FAULT_LEVEL : 4 errors in a row, or sustained errors on more
+ * than 1 in HALL_SEQUENCE_ERROR_WEIGHT transitions */
+#define HALL_SEQUENCE_ERROR_WEIGHT          8
+#define HALL_SEQUENCE_FAULT_LEVEL           32
+
+/* Phase advance = ((speed - startSpeed) * gain) >> PHASE_ADVANCE_GAIN_SHIFT */
+#define PHASE_ADVANCE_GAIN_SHIFT            12
      
 // </editor-fold> 
 
@@ -88,6 +118,15 @@ uint16_t MCAPP_HallSensorRead(MCAPP_HALL_INPUT_T *);
 void MCAPP_HallSensorValue(MCAPP_HALL_SENSOR_T *);
 void MCAPP_MeasureSpeed(MCAPP_HALL_SENSOR_T *);
 void HallSensorHandler(MCAPP_HALL_SENSOR_T *);
+void MCAPP_HallGlitchRecheck(MCAPP_HALL_SENSOR_T *);
+void MCAPP_HallSequenceCheckStart(MCAPP_HALL_SENSOR_T *);
+void MCAPP_HallSequenceCheckStop(MCAPP_HALL_SENSOR_T *);
+void MCAPP_HallCalibrationInit(MCAPP_HALL_SENSOR_T *);
+void MCAPP_HallCalibrationStart(MCAPP_HALL_SENSOR_T *);
+void MCAPP_HallPositionMapLoad(MCAPP_HALL_SENSOR_T *, const uint16_t *);
+void MCAPP_HallEdgeBufferInit(MCAPP_HALL_EDGE_BUFFER_T *);
+void MCAPP_HallEdgeBufferWrite(MCAPP_HALL_EDGE_BUFFER_T *, uint16_t, uint32_t);
+bool MCAPP_HallEdgeBufferRead(MCAPP_HALL_EDGE_BUFFER_T *, MCAPP_HALL_EDGE_T *);
     
 // </editor-fold>
 #ifdef	__cplusplus
@@ -54,9 +54,39 @@ extern "C" {
 // <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
 #include <stdint.h>
 #include <stdbool.h>
+#include "filter_types.h"
   
 // </editor-fold>
 
+// <editor-fold defaultstate="expanded" desc="DEFINITIONS/CONSTANTS ">
+
+/* Number of Hall edge records in the edge buffer - must be a power of 2 */
+#define HALL_EDGE_BUFFER_SIZE       16
+#define HALL_EDGE_BUFFER_MASK       (HALL_EDGE_BUFFER_SIZE - 1)
+
+/* Number of states of the three Hall inputs; with 120 degree sensors 0 and 7 
+ * are invalid, with 60 degree sensors two of 1 to 6 are invalid */
+#define HALL_STATES                 8
+/* Number of Hall sectors in one electrical revolution */
+#define HALL_SECTORS                6
+/* Position index of a Hall value not present in the identified sequence */
+#define HALL_POSITION_INVALID       0xFFFF
+/* Nominal sector width : 60 degrees electrical, 65536 = 360 degrees */
+#define HALL_SECTOR_WIDTH_NOMINAL   10923
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="ENUMERATED CONSTANTS ">
+
+typedef enum
+{
+    HALL_CALIB_IDLE = 0,        /* Calibration not requested */
+    HALL_CALIB_RUNNING = 1,     /* Accumulating sector periods */
+    HALL_CALIB_DONE = 2,        /* Sector widths learned */
+    HALL_CALIB_FAILED = 3,      /* Learned widths out of range, not applied */
+            
+}MCAPP_HALL_CALIB_STATE_T;
+// </editor-fold>
+
 // <editor-fold defaultstate="collapsed" desc="VARIABLE TYPE DEFINITIONS ">
 
 typedef struct
@@ -68,16 +98,131 @@ typedef struct
         hallValue;          /* Hall sector value */
 }MCAPP_HALL_INPUT_T;
 
+typedef struct
+{
+    uint16_t
+        hallValue;          /* Hall value after the edge */
+    uint32_t
+        timeStamp;          /* SCCP timer time of the edge (free running) */
+}MCAPP_HALL_EDGE_T;
+
+/* Hall sector width calibration : widths are learned from the periods of
+ * successive Hall edges over several revolutions at constant speed */
+typedef struct
+{
+    uint16_t
+        state,              /* Calibration state */
+        edgeCount,          /* Edges in the present revolution */
+        sectorsSeen,        /* Sectors seen in the present revolution (bits) */
+        revolutionCount,    /* Stable revolutions accumulated */
+        revolutionSectorPeriod[HALL_SECTORS], /* Periods of present revolution */
+        sectorWidth[HALL_SECTORS],  /* Sector width, 65536 = 360 degrees */
+        sectorStart[HALL_SECTORS],  /* Angle at the start of each sector */
+        correction[HALL_SECTORS];   /* Nominal to learned width ratio in Q14 */
+    
+    uint32_t
+        revolutionPeriod,       /* Sum of periods of present revolution */
+        lastRevolutionPeriod,   /* Sum of periods of previous revolution */
+        totalPeriod,            /* Sum of periods of stable revolutions */
+        sectorPeriodSum[HALL_SECTORS]; /* Sector periods of stable revolutions */
+    
+}MCAPP_HALL_CALIBRATION_T;
+
+/* Rotor angle interpolated between Hall edges */
+typedef struct
+{
+    uint16_t
+        angle,              /* Electrical angle, 65536 = 360 degrees */
+        angleInSector,      /* Angle travelled from start of present sector */
+        angleStep,          /* Angle increment per control period */
+        sectorIndex,        /* Position index (0 to 5) of present sector */
+        direction;          /* 0 = increasing position index, 1 = decreasing */
+    
+    uint32_t
+        stepMultiplier;     /* Angle step multiplier */
+    
+    bool
+        valid;              /* Set after two consecutive adjacent sectors */
+    
+}MCAPP_HALL_ANGLE_T;
+
+/* Speed dependent commutation phase advance */
+typedef struct
+{
+    uint16_t
+        startSpeed,         /* Speed at which advance starts */
+        gain,               /* Advance per unit speed above startSpeed */
+        maxAdvance,         /* Advance limit, 65536 = 360 degrees */
+        advance;            /* Present advance, 65536 = 360 degrees */
+    
+}MCAPP_HALL_ADVANCE_T;
+
+/* Hall edge glitch filter, executed in the CN interrupt and, after a 
+ * rejection, in the control interrupt */
+typedef struct
+{
+    uint16_t
+        minPeriod,          /* Shortest accepted period, SCCP timer counts */
+        rejectCount,        /* Consecutive rejected edges */
+        shortRejected,      /* Edges rejected as too short (diagnostics) */
+        sequenceRejected;   /* Edges rejected as out of sequence (diagnostics) */
+    
+    bool
+        recheck;            /* Last edge rejected, Hall inputs to be read again */
+    
+}MCAPP_HALL_GLITCH_FILTER_T;
+
+/* Next sector predictor checking Hall transitions against the identified 
+ * sequence, executed in the CN interrupt. The sequence fault is raised only
+ * while faultEnabled is set (motor running); otherwise the predictor only 
+ * tracks the direction of rotation of the coasting rotor */
+typedef struct
+{
+    uint16_t
+        lastIndex,          /* Position index of the last Hall value */
+        expectedValue,      /* Predicted next Hall value */
+        direction,          /* 0 = increasing position index, 1 = decreasing */
+        errorLevel,         /* Leaky count of sequence errors */
+        skipped,            /* Transitions skipping sectors (diagnostics) */
+        reversed;           /* Transitions against direction (diagnostics) */
+    
+    bool
+        faultEnabled;       /* Error level may raise the sequence fault */
+    
+}MCAPP_HALL_SEQUENCE_CHECK_T;
+
+/* Single producer (CN interrupt), single consumer ring of Hall edges */
+typedef struct
+{
+    MCAPP_HALL_EDGE_T
+        edge[HALL_EDGE_BUFFER_SIZE];    /* Hall edge records */
+    
+    volatile uint16_t
+        head,               /* Next record to write, owned by producer */
+        tail;               /* Next record to read, owned by consumer */
+    
+    uint16_t
+        overrun;            /* Edges dropped as the buffer was full */
+    
+    uint32_t
+        timeStamp;          /* Time built from SCCP periods of queued edges */
+}MCAPP_HALL_EDGE_BUFFER_T;
+
 typedef struct
 { 
     uint16_t
         timerValue,         /* SCCP Timer value on every Hall sequence change */
         period,             /* SCCP Timer value  */
         avgPeriod,          /* Moving average output of period */
-        speed;              /* Measured speed */
+        speed,              /* Measured speed */
+        sampleCount;        /* Incremented at every new speed value */
     
     uint32_t    
-        multiplier;    /* Speed Multiplier */
+        multiplier,    /* Speed Multiplier */
+        lastTimeStamp;      /* Time stamp of the last consumed Hall edge */
+    
+    MCAPP_FILTER_RING_AVG_T
+        periodFilter;       /* Moving average of the last Hall periods */
   
 }MCAPP_CALC_SPEED_T;
 
@@ -89,16 +234,34 @@ typedef struct
         presentValue,       /* Present value of Hall value */
         previousValue,      /* Previous value of Hall value */
         sector,             /* Hall sector number */
-        value;        /* Hall Sequence Value constructed based on Hall inputs */
+        value,        /* Hall Sequence Value constructed based on Hall inputs */
+        positionMap[HALL_STATES], /* Position index of each Hall value */
+        hallValueAt[HALL_SECTORS], /* Hall value at each position index */
+        commutationValue,   /* Hall value used to commutate */
+        edgeCount;          /* Valid Hall edges seen by the CN interrupt */
         
 
     bool 
+        validState[HALL_STATES], /* Hall values part of the sequence */
         hallChangeDetected, /* Hall sequence change detection flag */
         hallFailure,        /* Hall failure detection flag */
+        sequenceFault,      /* Hall sequence error level exceeded flag */
         timerError;       /* Timer failure detection flag */
 
     MCAPP_HALL_INPUT_T  hallInput;
     
+    MCAPP_HALL_EDGE_BUFFER_T hallEdgeBuffer;
+    
+    MCAPP_HALL_GLITCH_FILTER_T glitchFilter;
+    
+    MCAPP_HALL_SEQUENCE_CHECK_T sequenceCheck;
+    
+    MCAPP_HALL_CALIBRATION_T hallCalibration;
+    
+    MCAPP_HALL_ANGLE_T hallAngle;
+    
+    MCAPP_HALL_ADVANCE_T phaseAdvance;
+    
     MCAPP_CALC_SPEED_T calculateSpeed;
         
 }MCAPP_HALL_SENSOR_T;
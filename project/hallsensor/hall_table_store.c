@@ -0,0 +1,227 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * @file hall_table_store.c
+ *
+ * @brief This module saves the PWM override tables and the Hall position map
+ * found by the hall sequence identifier in a reserved page of program flash,
+ * and restores them at start up.
+ *
+ * Component: HALL SENSOR
+ *
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+#include <xc.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "hall_table_store.h"
+#include "flash.h"
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="VARIABLES ">
+
+/* Flash page reserved for the record; aligned and sized to an erase page so
+ * that no code or constant shares it */
+static const uint16_t __attribute__((space(prog),
+        aligned(FLASH_ERASE_PAGE_SIZE_IN_PC_UNITS)))
+    hallTableStorePage[FLASH_ERASE_PAGE_SIZE_IN_INSTRUCTIONS];
+
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="STATIC FUNCTIONS ">
+
+static uint16_t HallTableStore_CRC16(const uint16_t *, uint16_t);
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS ">
+
+/**
+* <B> Function: HallTableStore_Load(MCAPP_HALLSEQ_IDENT_T*) </B>
+*
+* @brief Function to restore the identified tables from flash. The tables are
+*        loaded only if the record format, the motor profile tag and the CRC
+*        match; otherwise the identifier data is left unchanged.
+*        .
+* @param Pointer to the data structure containing parameters of
+         the hall sequence identifier.
+* @return true if the tables were restored.
+* @example
+* <CODE> HallTableStore_Load(&hallSeqIdentifier); </CODE>
+*
+*/
+bool HallTableStore_Load(MCAPP_HALLSEQ_IDENT_T *pData)
+{
+    uint16_t record[HALL_TABLE_STORE_WORDS];
+    uint32_t address;
+    uint16_t i;
+    const uint16_t *pWord;
+
+    address = __builtin_tbladdress(hallTableStorePage);
+    for(i = 0; i < HALL_TABLE_STORE_WORDS; i++)
+    {
+        record[i] = FLASH_ReadWord16(address);
+        address += 2;
+    }
+
+    if((record[0] != HALL_TABLE_STORE_MAGIC) ||
+            (record[1] != HALL_TABLE_STORE_VERSION) ||
+            (record[2] != HALL_TABLE_STORE_MOTOR_TAG))
+    {
+        return false;
+    }
+    if(record[HALL_TABLE_STORE_WORDS - 1] !=
+            HallTableStore_CRC16(record, HALL_TABLE_STORE_WORDS - 1))
+    {
+        return false;
+    }
+
+    pWord = &record[HALL_TABLE_STORE_HEADER_WORDS];
+    for(i = 0; i < HALL_STATES; i++)
+    {
+        pData->ovrDataOut[i]     = pWord[i];
+        pData->sectorPosition[i] = pWord[i + HALL_STATES];
+        pData->sectorSequence[i] =
+                (pData->sectorPosition[i] != HALL_POSITION_INVALID) ? i : 0;
+    }
+
+    return true;
+}
+
+/**
+* <B> Function: HallTableStore_Save(MCAPP_HALLSEQ_IDENT_T*) </B>
+*
+* @brief Function to save the identified tables to flash.
+*        CPU stalls for the page erase and programming : call only from the 
+*        main loop (never from an interrupt) while PWM outputs are disabled.
+*        .
+* @param Pointer to the data structure containing parameters of
+         the hall sequence identifier.
+* @return true if the record was written and read back correctly.
+* @example
+* <CODE> HallTableStore_Save(&hallSeqIdentifier); </CODE>
+*
+*/
+bool HallTableStore_Save(const MCAPP_HALLSEQ_IDENT_T *pData)
+{
+    uint16_t record[HALL_TABLE_STORE_WORDS];
+    uint32_t address;
+    uint16_t i;
+    uint16_t *pWord;
+
+    record[0] = HALL_TABLE_STORE_MAGIC;
+    record[1] = HALL_TABLE_STORE_VERSION;
+    record[2] = HALL_TABLE_STORE_MOTOR_TAG;
+
+    pWord = &record[HALL_TABLE_STORE_HEADER_WORDS];
+    for(i = 0; i < HALL_STATES; i++)
+    {
+        pWord[i]               = pData->ovrDataOut[i];
+        pWord[i + HALL_STATES] = pData->sectorPosition[i];
+    }
+    record[HALL_TABLE_STORE_WORDS - 1] =
+            HallTableStore_CRC16(record, HALL_TABLE_STORE_WORDS - 1);
+
+    address = __builtin_tbladdress(hallTableStorePage);
+    if(FLASH_ErasePage(address) == false)
+    {
+        return false;
+    }
+    for(i = 0; i < HALL_TABLE_STORE_WORDS; i += 2)
+    {
+        if(FLASH_WriteDoubleWord16(address, record[i], record[i + 1]) == false)
+        {
+            return false;
+        }
+        address += 4;
+    }
+
+    /* Verify the record */
+    address = __builtin_tbladdress(hallTableStorePage);
+    for(i = 0; i < HALL_TABLE_STORE_WORDS; i++)
+    {
+        if(FLASH_ReadWord16(address) != record[i])
+        {
+            return false;
+        }
+        address += 2;
+    }
+
+    return true;
+}
+
+// </editor-fold>
+
+/**
+* <B> Function: HallTableStore_CRC16(const uint16_t *, uint16_t) </B>
+*
+* @brief Function to compute CRC-16-CCITT (polynomial 0x1021, initial value
+*        0xFFFF) of 16-bit words, most significant byte first.
+*        .
+* @param Pointer to the words.
+* @param Number of words.
+* @return CRC.
+* @example
+* <CODE> HallTableStore_CRC16(record, length); </CODE>
+*
+*/
+static uint16_t HallTableStore_CRC16(const uint16_t *pWord, uint16_t length)
+{
+    uint16_t crc = 0xFFFF;
+    uint16_t i, bit;
+
+    for(i = 0; i < length; i++)
+    {
+        crc ^= pWord[i];
+        for(bit = 0; bit < 16; bit++)
+        {
+            if(crc & 0x8000)
+            {
+                crc = (crc << 1) ^ 0x1021;
+            }
+            else
+            {
+                crc = crc << 1;
+            }
+        }
+    }
+
+    return crc;
+}
@@ -0,0 +1,96 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * @file hall_table_store.h
+ *
+ * @brief This header file lists definitions and interface functions to keep
+ * the result of the hall sequence identifier in program flash memory.
+ *
+ * Component: HALL SENSOR
+ *
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+
+#ifndef HALL_TABLE_STORE_H
+#define	HALL_TABLE_STORE_H
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+#include <stdint.h>
+#include <stdbool.h>
+#include "hall_identifier.h"
+#include "mc1_user_params.h"
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="DEFINITIONS/CONSTANTS ">
+
+/* Record identification ('HS') and format version. The version must be
+ * changed whenever the record layout changes */
+#define HALL_TABLE_STORE_MAGIC          0x4853
+#define HALL_TABLE_STORE_VERSION        3
+/* Motor profile tag : a table identified on another motor is not loaded */
+#define HALL_TABLE_STORE_MOTOR_TAG      (uint16_t)((MOTOR << 8) | POLE_PAIRS)
+
+/* Record layout (16-bit words) :
+ * magic, version, motor tag, ovrDataOut[HALL_STATES], 
+ * sectorPosition[HALL_STATES], CRC */
+#define HALL_TABLE_STORE_HEADER_WORDS   3
+#define HALL_TABLE_STORE_DATA_WORDS     (HALL_STATES * 2)
+#define HALL_TABLE_STORE_WORDS          (HALL_TABLE_STORE_HEADER_WORDS + \
+                                            HALL_TABLE_STORE_DATA_WORDS + 1)
+/* The record is programmed in double words */
+#if (HALL_TABLE_STORE_WORDS & 1)
+    #error HALL_TABLE_STORE_WORDS must be even
+#endif
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS ">
+
+bool HallTableStore_Load(MCAPP_HALLSEQ_IDENT_T *);
+bool HallTableStore_Save(const MCAPP_HALLSEQ_IDENT_T *);
+
+// </editor-fold>
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* HALL_TABLE_STORE_H */
@@ -53,6 +53,7 @@
 
 #include "board_service.h"
 #include "diagnostics.h"
+#include "profiler.h"
 
 #include "mc1_service.h" 
 #include "mc1_init.h"
@@ -88,12 +89,18 @@ int main (void)
     DiagnosticsInit();
 #endif
 
+#ifdef ENABLE_ISR_PROFILER
+    /* Initialize ISR execution time profiler */
+    ProfilerInit();
+#endif
+
     MCAPP_MC1ServiceInit(); 
     
     runCmdMC1  = 0;
     
     while(1)
     {
+        MCAPP_MC1ServiceStepMain();
         
 #ifdef ENABLE_DIAGNOSTICS
         DiagnosticsStepMain();
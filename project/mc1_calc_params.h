@@ -59,6 +59,7 @@ extern "C" {
 #include "mc1_user_params.h"
 #include "general.h"
 #include "pwm.h"
+#include "hall_sensor.h"
 // </editor-fold>
 
 // <editor-fold defaultstate="expanded" desc="DEFINITIONS/MACROS ">
@@ -66,6 +67,24 @@ extern "C" {
 /* SPEED MULTIPLIER CALCULATION = ((FCY*60)/(TIMER_PRESCALER*POLEPAIRS*6))  */
 #define SPEED_MULTIPLIER     (uint32_t)(((float)FCY/(float)(SPEED_MEASURE_TIMER_PRESCALER*POLE_PAIRS*6))*(float)60)     
         
+/* ANGLE STEP MULTIPLIER CALCULATION : angle (65536 = 360 degrees) travelled 
+   in one control period, for a Hall period of 1 SCCP timer count 
+   = ((65536/6)*FCY)/(TIMER_PRESCALER*PWMFREQUENCY_HZ) */
+#define HALL_ANGLE_STEP_MULTIPLIER  (uint32_t)(((float)FCY/(float)(SPEED_MEASURE_TIMER_PRESCALER*PWMFREQUENCY_HZ))*((float)65536/6))
+        
+/* Phase advance curve : advance (65536 = 360 degrees) = 
+   ((speed - PHASE_ADVANCE_START_SPEED)*PHASE_ADVANCE_GAIN)>>PHASE_ADVANCE_GAIN_SHIFT */
+#define PHASE_ADVANCE_START_SPEED   (uint16_t)PHASE_ADVANCE_START_RPM
+#define PHASE_ADVANCE_MAX           (uint16_t)(PHASE_ADVANCE_MAX_DEG*65536/360)
+#define PHASE_ADVANCE_GAIN          (uint16_t)((float)PHASE_ADVANCE_MAX*(1 << PHASE_ADVANCE_GAIN_SHIFT)/(MAXIMUM_SPEED_RPM - PHASE_ADVANCE_START_RPM))
+        
+/* BEMF SPEED MULTIPLIER CALCULATION = ((PWMFREQUENCY_HZ*60)/POLEPAIRS) :
+   speed from the length of an electrical revolution in control periods */
+#define BEMF_SPEED_MULTIPLIER   (uint32_t)(((float)PWMFREQUENCY_HZ*60)/POLE_PAIRS)
+
+/* Shortest Hall period accepted by the glitch filter in SCCP timer counts */
+#define HALL_GLITCH_MIN_PERIOD  (uint16_t)(((float)HALL_GLITCH_MIN_PERIOD_USEC*FCY_MHZ)/SPEED_MEASURE_TIMER_PRESCALER)
+        
 /* Normalized current value */
 #define NORM_CURRENT_CONST     (float)(MAX_BOARDCURRENT/32767)    
 /* Current transformation macro, used below */
@@ -56,6 +56,7 @@
 #include "board_service.h"
 #include "mc1_user_params.h"
 #include "mc1_calc_params.h"
+#include "sixstep_control.h"
 
 // </editor-fold>
 
@@ -118,8 +119,11 @@ void MCAPP_MC1ControlSchemeConfig(MC1APP_DATA_T *pMCData)
     pControlScheme->pDirectionCmd = &pMCData->directionCmd;
     pControlScheme->pMeasuredSpeed = 
                         &pMotorInputs->detectRotorPosition.calculateSpeed.speed;
-    pControlScheme->pSector = &pMotorInputs->detectRotorPosition.value;
+    pControlScheme->pSector = 
+                        &pMotorInputs->detectRotorPosition.commutationValue;
     pControlScheme->pAvgCurrent = &pMotorInputs->filterBusCurrent;
+    pControlScheme->pSpeedSampleCount = 
+                &pMotorInputs->detectRotorPosition.calculateSpeed.sampleCount;
     
     /* Initialize Motor parameters */
     pControlScheme->motor.MaxSpeed        = (uint16_t) MAXIMUM_SPEED_RPM;
@@ -133,6 +137,8 @@ void MCAPP_MC1ControlSchemeConfig(MC1APP_DATA_T *pMCData)
     pControlScheme->ctrlParam.controlLoop = SPEED_CONTROL;
 #elif CLOSED_LOOP == 2
     pControlScheme->ctrlParam.controlLoop = CURRENT_CONTROL;
+#elif CLOSED_LOOP == 3
+    pControlScheme->ctrlParam.controlLoop = SPEED_CURRENT_CONTROL;
 #else 
     pControlScheme->ctrlParam.controlLoop = SPEED_CONTROL;
 #endif       
@@ -140,21 +146,62 @@ void MCAPP_MC1ControlSchemeConfig(MC1APP_DATA_T *pMCData)
     /* Initialize startup parameters */
     pMotorInputs->detectRotorPosition.calculateSpeed.multiplier = 
                                                     (uint32_t) SPEED_MULTIPLIER;   
+    pMotorInputs->detectRotorPosition.hallAngle.stepMultiplier = 
+                                        (uint32_t) HALL_ANGLE_STEP_MULTIPLIER;
+    MCAPP_HallCalibrationInit(&pMotorInputs->detectRotorPosition);
+    pMotorInputs->detectRotorPosition.glitchFilter.minPeriod = 
+                                        (uint16_t) HALL_GLITCH_MIN_PERIOD;
+    
+    /* Configure BEMF zero crossing detector inputs */
+    pMotorInputs->bemfZeroCross.pHallValue = &pControlScheme->sector;
+    pMotorInputs->bemfZeroCross.pTableIndex = 
+                                        &pControlScheme->commutationSector;
+    pMotorInputs->bemfZeroCross.pPositionMap = 
+                            pMotorInputs->detectRotorPosition.positionMap;
+    pMotorInputs->bemfZeroCross.pHallValueAt = 
+                            pMotorInputs->detectRotorPosition.hallValueAt;
+    pMotorInputs->bemfZeroCross.pOverrideTable = pMCData->hallSeqIdent.ovrDataOut;
+    pMotorInputs->bemfZeroCross.speedMultiplier = 
+                                            (uint32_t) BEMF_SPEED_MULTIPLIER;
+#ifdef ENABLE_PHASE_ADVANCE
+    pMotorInputs->detectRotorPosition.phaseAdvance.startSpeed = 
+                                        (uint16_t) PHASE_ADVANCE_START_SPEED;
+    pMotorInputs->detectRotorPosition.phaseAdvance.gain = 
+                                        (uint16_t) PHASE_ADVANCE_GAIN;
+    pMotorInputs->detectRotorPosition.phaseAdvance.maxAdvance = 
+                                        (uint16_t) PHASE_ADVANCE_MAX;
+#endif
     pMotorInputs->detectRotorPosition.motorStopValue = 
                                        (uint16_t) DIRECTION_CHANGE_SPEED_COUNTS;
     
     /* Initialize PI controller used for current control */
     pControlScheme->piCurrentInput.piState.kp          =   CURRCNTR_PTERM;
-    pControlScheme->piCurrentInput.piState.ki          =   CURRCNTR_ITERM;
+    pControlScheme->piCurrentInput.piState.ki          =   
+                                LOOP_RATE_SCALED(CURRCNTR_ITERM);
     pControlScheme->piCurrentInput.piState.kc          =   CURRCNTR_CTERM;
     pControlScheme->piCurrentInput.piState.outMax      =   CURRCNTR_OUTMAX;
 
     /* Initialize PI controller used for speed control */
+#if CLOSED_LOOP == 3
+    /* Output is the current reference; the integral gain is set at every 
+       execution from the control periods elapsed since the last one */
+    pControlScheme->piSpeedInput.piState.kp          =   SPDCURCNTR_PTERM;
+    pControlScheme->speedLoopKi = 
+                            (int16_t)LOOP_RATE_SCALED(SPDCURCNTR_ITERM);
+    pControlScheme->piSpeedInput.piState.ki          =   
+                                            pControlScheme->speedLoopKi;
+    pControlScheme->piSpeedInput.piState.kc          =   SPDCURCNTR_CTERM;
+    pControlScheme->piSpeedInput.piState.outMax      =   SPDCURCNTR_OUTMAX;
+    pControlScheme->piSpeedInput.piState.outMin      =   SPDCURCNTR_OUTMIN;
+#else
     pControlScheme->piSpeedInput.piState.kp          =   SPEEDCNTR_PTERM;
-    pControlScheme->piSpeedInput.piState.ki          =   SPEEDCNTR_ITERM;
+    /* Integral gain compensates for the decimated speed loop rate */
+    pControlScheme->piSpeedInput.piState.ki          =   
+            LOOP_RATE_SCALED(SPEEDCNTR_ITERM * SPEED_LOOP_TASK_DIVISOR);
     pControlScheme->piSpeedInput.piState.kc          =   SPEEDCNTR_CTERM;
     pControlScheme->piSpeedInput.piState.outMax      =   SPEEDCNTR_OUTMAX;
     pControlScheme->piSpeedInput.piState.outMin      =   SPEEDCNTR_OUTMIN;
+#endif
     pControlScheme->piSpeedInput.piState.integrator  =   0;
     
     /* Output Initializations */
@@ -69,6 +69,10 @@ extern "C" {
 // <editor-fold defaultstate="collapsed" desc="DEFINITIONS ">
     
 #define MCAPP_CONTROL_SCHEME_T              MCAPP_BLDC_SIXSTEP_CONTROL_T
+
+/* Valid Hall edges needed after a stop before catching the rotor : the
+   first two set the direction of rotation, the next confirms it */
+#define FLYING_START_MIN_EDGES              3
     
 // </editor-fold>
     
@@ -102,11 +106,31 @@ typedef enum
     MCAPP_HALL_FAILURE = 3,             /* Hall sensor feedback fault */
     MCAPP_TIMER_ERROR = 4,              /* Timer value error */
     MCAPP_HALLSEQ_IDENT_FAILURE = 5,    /* Failure in detecting Hall sequence */
+    MCAPP_HALL_SEQUENCE_FAULT = 6,      /* Hall transitions out of sequence */
+    MCAPP_BEMF_FAILURE = 7,             /* BEMF zero crossing lost */
 
 }MCAPP_FAULTS_T;
     
 // <editor-fold defaultstate="collapsed" desc="VARIABLE TYPE DEFINITIONS ">
 
+/* Flying start : operating point of the last run, the duty cycle matching
+   the BEMF of the coasting rotor is scaled from it */
+typedef struct
+{
+    uint16_t
+        refDuty,            /* Duty cycle when the motor was stopped */
+        refSpeed,           /* Speed when the motor was stopped */
+        refVdc,             /* DC bus voltage when the motor was stopped */
+        refDirection,       /* Direction of rotation, 0 = increasing position
+                               index */
+        refDirectionCmd,    /* Direction command when the motor was stopped */
+        catchCount;         /* Restarts of a coasting motor (diagnostics) */
+    
+    bool
+        valid;              /* Operating point captured */
+    
+}MCAPP_FLYING_START_T;
+
 typedef struct
 {
     uint16_t
@@ -126,6 +150,10 @@ typedef struct
     
     MCAPP_HALLSEQ_IDENT_T
         hallSeqIdent;               /* Hall sequence identifier parameters */
+    
+    MCAPP_FLYING_START_T
+        flyingStart;                /* Restart of a coasting motor */
+    
     MCAPP_MEASURE_T *pMotorInputs;
     
     MCAPP_CONTROL_SCHEME_T *pControlScheme;    
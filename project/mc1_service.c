@@ -51,10 +51,13 @@
 
 #include <libq.h>
 #include "diagnostics.h"
+#include "profiler.h"
 #include "board_service.h"
 #include "mc1_init.h"
 #include "sixstep_control.h"
 #include "mc1_user_params.h"
+#include "hall_table_store.h"
+#include "bemf_zero_cross.h"
 // </editor-fold>
 
 // <editor-fold defaultstate="expanded" desc="VARIABLES ">
@@ -69,6 +72,10 @@ MC1APP_DATA_T *pMC1Data = &mc1;
 static void MC1APP_StateMachine(MC1APP_DATA_T *);
 static void MCAPP_MC1ReceivedDataProcess(MC1APP_DATA_T *);
 static void MCAPP_HallSequenceIdentifier(MC1APP_DATA_T *);
+#ifdef ENABLE_FLYING_START
+static void MCAPP_FlyingStartCapture(MC1APP_DATA_T *);
+static bool MCAPP_FlyingStartDuty(MC1APP_DATA_T *, uint16_t *);
+#endif
 
 // </editor-fold>
 
@@ -88,12 +95,22 @@ static void MC1APP_StateMachine(MC1APP_DATA_T *pMCData)
 {
     MCAPP_MEASURE_T *pMotorInputs = pMCData->pMotorInputs;
     MCAPP_CONTROL_SCHEME_T *pControlScheme = pMCData->pControlScheme;
+#ifdef ENABLE_FLYING_START
+    uint16_t flyingStartDuty;
+#endif
 
     switch(pMCData->appState)
     {
     case MCAPP_INIT:
 
         HAL_MC1PWMDisableOutputs();
+#ifdef ENABLE_BEMF_FALLBACK
+        if(pMotorInputs->bemfZeroCross.active)
+        {
+            /* Back to the Hall sensors after a BEMF commutated run */
+            MC1_EnableCNInterrupt();
+        }
+#endif
 
         /* Stop the motor */
         pMCData->runCmd = 0;       
@@ -124,6 +141,33 @@ static void MC1APP_StateMachine(MC1APP_DATA_T *pMCData)
         
     case MCAPP_CMD_WAIT:
         
+#ifdef ENABLE_HALLSEQ_TABLE_STORE
+        if(pMCData->hallSeqIdent.tableSavePending == 1)
+        {
+            /* PWM outputs stay disabled until the tables are saved */
+            break;
+        }
+#endif
+#ifdef ENABLE_FLYING_START
+        /* Keep track of speed and direction while the motor coasts */
+        MCAPP_MeasureSpeed(&pMotorInputs->detectRotorPosition);
+        if(pMotorInputs->detectRotorPosition.motorStopCounter > 0)
+        {
+            pMotorInputs->detectRotorPosition.motorStopCounter--;
+        }
+        if((pMCData->runCmd == 1) && 
+                        MCAPP_FlyingStartDuty(pMCData, &flyingStartDuty))
+        {
+            /* Bootstrap capacitors are still charged and current offsets
+               are kept from the last run */
+            HAL_MC1PWMEnableOutputs();
+            MCAPP_HallSequenceCheckStart(&pMotorInputs->detectRotorPosition);
+            MCAPP_SixStepControlPreload(pControlScheme, flyingStartDuty);
+            pMCData->flyingStart.catchCount++;
+            pMCData->appState = MCAPP_RUN;
+            break;
+        }
+#endif
         if(pMCData->runCmd == 1)
         {
             /* Function call to charge Bootstrap capacitors*/
@@ -141,7 +185,14 @@ static void MC1APP_StateMachine(MC1APP_DATA_T *pMCData)
         {
             /* Detect Hall initial position */
             MCAPP_HallSensorValue(&pMotorInputs->detectRotorPosition);
+            /* Hall edges queued while stopped are not consumed : discard 
+               them, so that neither overruns nor stale periods reach the 
+               speed filter and the sector calibration */
+            MCAPP_HallEdgeBufferInit(
+                        &pMotorInputs->detectRotorPosition.hallEdgeBuffer);
+            pMotorInputs->detectRotorPosition.calculateSpeed.lastTimeStamp = 0;
             HAL_MC1PWMEnableOutputs();
+            MCAPP_HallSequenceCheckStart(&pMotorInputs->detectRotorPosition);
             pMCData->appState = MCAPP_RUN;
         }
 
@@ -153,6 +204,10 @@ static void MC1APP_StateMachine(MC1APP_DATA_T *pMCData)
         {
             /* Disable PWM outputs while motor is slowing down for change direction*/
             HAL_MC1PWMDisableOutputs();
+            MCAPP_HallSequenceCheckStop(&pMotorInputs->detectRotorPosition);
+#ifdef ENABLE_FLYING_START
+            MCAPP_FlyingStartCapture(pMCData);
+#endif
             /* Change run direction */
             pMCData->appState = MCAPP_DIRECTION_CHANGE;
             break;
@@ -161,9 +216,41 @@ static void MC1APP_StateMachine(MC1APP_DATA_T *pMCData)
         /* Compensate motor current offsets */
         MCAPP_MeasureCurrentCalibrate(pMotorInputs);
 
-        MCAPP_MeasureSpeed(&pMotorInputs->detectRotorPosition);
+        PROFILER_SECTION_START(PROFILER_MEASURE_SPEED);
+#ifdef ENABLE_BEMF_FALLBACK
+        MCAPP_BemfZeroCrossStep(&pMotorInputs->bemfZeroCross,
+                                &pMotorInputs->measurePhaseVolt,
+                                pMotorInputs->measureVdc.value);
+        if(pMotorInputs->bemfZeroCross.active)
+        {
+            /* Hall sensors failed : commutation and speed from the BEMF */
+            MCAPP_HALL_SENSOR_T *pHallSensor = 
+                                        &pMotorInputs->detectRotorPosition;
+            pHallSensor->commutationValue = 
+                                pMotorInputs->bemfZeroCross.commutationValue;
+            pHallSensor->calculateSpeed.speed = 
+                                        pMotorInputs->bemfZeroCross.speed;
+            pHallSensor->calculateSpeed.sampleCount = 
+                                    pMotorInputs->bemfZeroCross.sampleCount;
+        }
+        else
+#endif
+        {
+            MCAPP_MeasureSpeed(&pMotorInputs->detectRotorPosition);
+        }
+        PROFILER_SECTION_STOP(PROFILER_MEASURE_SPEED);
+#ifdef ENABLE_BEMF_FALLBACK
+        if(pMotorInputs->bemfZeroCross.failure)
+        {
+            pMCData->faultStatus = MCAPP_BEMF_FAILURE;
+            pMCData->appState = MCAPP_FAULT;
+            break;
+        }
+#endif
  
+        PROFILER_SECTION_START(PROFILER_CONTROL_STATE_MACHINE);
         MCAPP_SixStepControlStateMachine(pControlScheme);
+        PROFILER_SECTION_STOP(PROFILER_CONTROL_STATE_MACHINE);
         
         /* Check for control scheme faults */
         if(pControlScheme->faultStatus == 1 ) 
@@ -175,6 +262,9 @@ static void MC1APP_StateMachine(MC1APP_DATA_T *pMCData)
 
         if (pMCData->runCmd == 0)
         {
+#ifdef ENABLE_FLYING_START
+            MCAPP_FlyingStartCapture(pMCData);
+#endif
             /* Exit loop if motor not run */
             pMCData->appState = MCAPP_STOP;
         }
@@ -183,6 +273,15 @@ static void MC1APP_StateMachine(MC1APP_DATA_T *pMCData)
 
     case MCAPP_DIRECTION_CHANGE:
         
+#ifdef ENABLE_FLYING_START
+        if(pMCData->directionCmdBuffer == pMCData->directionCmd)
+        {
+            /* Direction change withdrawn : catch the motor on the fly */
+            pMCData->directionCmdFlag = 0;
+            pMCData->appState = MCAPP_INIT;
+            break;
+        }
+#endif
         /* Check if motor has stopped */
         if(pMotorInputs->detectRotorPosition.motorStopCounter == 0)
         {
@@ -202,6 +301,7 @@ static void MC1APP_StateMachine(MC1APP_DATA_T *pMCData)
 
     case MCAPP_STOP:
         HAL_MC1PWMDisableOutputs();
+        MCAPP_HallSequenceCheckStop(&pMotorInputs->detectRotorPosition);
         pMCData->appState = MCAPP_INIT;
         
         break;
@@ -210,6 +310,7 @@ static void MC1APP_StateMachine(MC1APP_DATA_T *pMCData)
         /* Based on the application handle the fault state appropriately, 
            in this example there is no recovery from fault state */
         HAL_MC1PWMDisableOutputs();
+        MCAPP_HallSequenceCheckStop(&pMotorInputs->detectRotorPosition);
         
         break;
         
@@ -219,15 +320,35 @@ static void MC1APP_StateMachine(MC1APP_DATA_T *pMCData)
 
     } /* end of switch-case */
     
-    /* Fault Handler */
+    /* Fault Handler : the sequence fault is raised while the motor runs only */
     if (pMotorInputs->detectRotorPosition.hallFailure == 1 || 
-                            pMotorInputs->detectRotorPosition.timerError == 1)
+                            pMotorInputs->detectRotorPosition.timerError == 1 ||
+                ((pMotorInputs->detectRotorPosition.sequenceFault == 1) &&
+                                        (pMCData->appState == MCAPP_RUN)))
     {
+#ifdef ENABLE_BEMF_FALLBACK
+        /* Keep the motor running on the BEMF if the zero crossings have been
+           found reliably; Hall inputs are ignored until the next start */
+        if((pMCData->appState == MCAPP_RUN) && 
+                MCAPP_BemfZeroCrossTakeOver(&pMotorInputs->bemfZeroCross,
+                pMotorInputs->detectRotorPosition.sequenceCheck.direction))
+        {
+            MC1_DisableCNInterrupt();
+            pMotorInputs->detectRotorPosition.hallFailure = 0;
+            pMotorInputs->detectRotorPosition.timerError = 0;
+            pMotorInputs->detectRotorPosition.sequenceFault = 0;
+            return;
+        }
+#endif
         HAL_MC1PWMDisableOutputs();
         if(pMotorInputs->detectRotorPosition.hallFailure == 1)
         {
             pMCData->faultStatus = MCAPP_HALL_FAILURE;
         }
+        else if(pMotorInputs->detectRotorPosition.sequenceFault == 1)
+        {
+            pMCData->faultStatus = MCAPP_HALL_SEQUENCE_FAULT;
+        }
         else
         {
             pMCData->faultStatus = MCAPP_TIMER_ERROR;
@@ -260,6 +381,14 @@ static void MCAPP_HallSequenceIdentifier(MC1APP_DATA_T *pMCData)
             /* Initialize the identifier parameters. */
             HallSeqIdentifier_Init(&pMCData->hallSeqIdent,pMCData->pControlScheme->pwmPeriod);
             pMCData->hallSeqIdent.state = MCAPP_HALLSEQ_OFFSET;
+#ifdef ENABLE_HALLSEQ_TABLE_STORE
+            /* Fast start : use the tables saved for this motor, if valid */
+            if(HallTableStore_Load(&pMCData->hallSeqIdent))
+            {
+                pMCData->hallSeqIdent.tableRestored = 1;
+                pMCData->hallSeqIdent.state = MCAPP_HALLSEQ_COMPLETE;
+            }
+#endif
             break;
         case MCAPP_HALLSEQ_OFFSET:
             /* Measure Initial Offsets */
@@ -290,11 +419,23 @@ static void MCAPP_HallSequenceIdentifier(MC1APP_DATA_T *pMCData)
         case MCAPP_HALLSEQ_COMPLETE:
             
             /* Load the inverter switching array */
-            MCAPP_LoadInverterSwitchingArray(pMCData->hallSeqIdent.ovrDataOutPWM3, 
-                    pMCData->hallSeqIdent.ovrDataOutPWM2,
-                    pMCData->hallSeqIdent.ovrDataOutPWM1);
-            /* Setting the ADC sampling point for the control */
-            SetADCSamplingPoint(ADC_SAMPLING_POINT1);
+            MCAPP_LoadInverterSwitchingArray(pMCData->hallSeqIdent.ovrDataOut);
+            /* Load the Hall value to rotor position map for angle 
+               interpolation; starts learning of the sector widths */
+            MCAPP_HallPositionMapLoad(
+                    &pMCData->pMotorInputs->detectRotorPosition,
+                    pMCData->hallSeqIdent.sectorPosition);
+#ifdef ENABLE_HALLSEQ_TABLE_STORE
+            /* The identified tables are saved by the main loop, flash 
+               erase and write stall the CPU */
+            if(pMCData->hallSeqIdent.tableRestored == 0)
+            {
+                pMCData->hallSeqIdent.tableSavePending = 1;
+            }
+#endif
+            /* Setting the ADC sampling point for the control : follows the
+               duty cycle */
+            SetADCSamplingPoint(ADC_SAMPLING_POINT_DUTY);
             MC1_EnableCNInterrupt();
 
             /* Indicates the hall sequence identification is completed.  */
@@ -329,25 +470,44 @@ void __attribute__((__interrupt__,no_auto_psv)) MC1_ADC_INTERRUPT()
 {
     int16_t __attribute__((__unused__)) adcBuffer;
     
+    PROFILER_SECTION_START(PROFILER_ADC_ISR);
+    
     #ifdef ENABLE_DIAGNOSTICS
+        PROFILER_SECTION_START(PROFILER_DIAGNOSTICS_ISR);
         DiagnosticsStepIsr();
+        PROFILER_SECTION_STOP(PROFILER_DIAGNOSTICS_ISR);
     #endif
     
     HAL_MC1MotorInputsRead(pMC1Data->pMotorInputs);
     
+#ifdef ENABLE_HALL_GLITCH_FILTER
+    if(MC1_IsCNInterruptEnabled())
+    {
+        /* Hall inputs are read again after a rejected Hall edge */
+        MCAPP_HallGlitchRecheck(
+                            &pMC1Data->pMotorInputs->detectRotorPosition);
+    }
+#endif
+    
+    PROFILER_SECTION_START(PROFILER_APP_STATE_MACHINE);
     MC1APP_StateMachine(pMC1Data);
+    PROFILER_SECTION_STOP(PROFILER_APP_STATE_MACHINE);
     
     HAL_PWM_DutyCycleRegister_Set(pMC1Data->pControlScheme->pwmDuty);
     
     adcBuffer = MC1_ClearADCIF_ReadADCBUF();
 	MC1_ClearADCIF();
+    
+    PROFILER_SECTION_STOP(PROFILER_ADC_ISR);
 }
 
 /**
 * <B> Function: MC1_HallCN_INTERRUPT()     </B>
 *
 * @brief Function to service Hall signal transition and 
-* read the SCCP timer value to calculate speed. 
+* read the SCCP timer value to calculate speed. With ENABLE_CN_COMMUTATION
+* the commutation pattern of a valid new Hall value is applied here while 
+* the motor runs.
 *        
 * @param none.
 * @return none.
@@ -357,7 +517,21 @@ void __attribute__((__interrupt__,no_auto_psv)) MC1_ADC_INTERRUPT()
 */
 void __attribute__((__interrupt__,no_auto_psv)) MC1_HallCN_Interrupt()
 {
-    HallSensorHandler(&pMC1Data->pMotorInputs->detectRotorPosition);
+    MCAPP_HALL_SENSOR_T *pHallSensor = 
+                            &pMC1Data->pMotorInputs->detectRotorPosition;
+#ifdef ENABLE_CN_COMMUTATION
+    uint16_t edgeCount = pHallSensor->edgeCount;
+#endif
+    
+    HallSensorHandler(pHallSensor);
+#ifdef ENABLE_CN_COMMUTATION
+    if((pHallSensor->edgeCount != edgeCount) && 
+                                        (pMC1Data->appState == MCAPP_RUN))
+    {
+        MCAPP_SixStepEdgeCommutate(pMC1Data->pControlScheme, 
+                                                        pHallSensor->value);
+    }
+#endif
     MC1_ClearCNIF(); 
 }
 
@@ -380,6 +554,36 @@ void __attribute__((__interrupt__,no_auto_psv)) _PWMInterrupt()
     ClearPWMIF(); 
 }
 
+/**
+* <B> Function: void MCAPP_MC1ServiceStepMain (void)  </B>
+*
+* @brief Function to execute the MC1 tasks that are not time critical or 
+*        must not run in an interrupt. Called from the main loop.
+*
+* @param none.
+* @return none.
+* 
+* @example
+* <CODE> MCAPP_MC1ServiceStepMain(); </CODE>
+*
+*/
+void MCAPP_MC1ServiceStepMain(void)
+{
+#ifdef ENABLE_HALLSEQ_TABLE_STORE
+    if(mc1.hallSeqIdent.tableSavePending == 1)
+    {
+        /* PWM outputs are disabled while the save is pending */
+        if(HallTableStore_Save(&mc1.hallSeqIdent) == false)
+        {
+            /* The identified tables stay in use until the next reset; the
+               record in flash may be missing or left unchanged */
+            mc1.hallSeqIdent.tableSaveFailed = 1;
+        }
+        mc1.hallSeqIdent.tableSavePending = 0;
+    }
+#endif
+}
+
 /**
 * <B> Function: void MCAPP_MC1ServiceInit (void)  </B>
 *
@@ -422,6 +626,103 @@ void MCAPP_MC1InputBufferSet(uint16_t runCmd, uint16_t directionCmd )
     MCAPP_MC1ReceivedDataProcess(pMC1Data);
 }
 
+#ifdef ENABLE_FLYING_START
+/**
+* <B> Function: void MCAPP_FlyingStartCapture (MC1APP_DATA_T *)  </B>
+*
+* @brief Function to record the operating point of the motor when it is 
+*        stopped; the duty cycle is nearly that matching the BEMF at the 
+*        measured speed and DC bus voltage.
+*
+* @param Pointer to the data structure containing Application parameters.
+* @return none.
+* 
+* @example
+* <CODE> MCAPP_FlyingStartCapture(&pMCData); </CODE>
+*
+*/
+static void MCAPP_FlyingStartCapture(MC1APP_DATA_T *pMCData)
+{
+    MCAPP_FLYING_START_T *pFlyingStart = &pMCData->flyingStart;
+    MCAPP_MEASURE_T *pMotorInputs = pMCData->pMotorInputs;
+    MCAPP_HALL_SENSOR_T *pHallSensor = &pMotorInputs->detectRotorPosition;
+    
+    pFlyingStart->refDuty         = pMCData->pControlScheme->pwmDuty;
+    pFlyingStart->refSpeed        = pHallSensor->calculateSpeed.speed;
+    pFlyingStart->refVdc          = (uint16_t)pMotorInputs->measureVdc.value;
+    pFlyingStart->refDirection    = pHallSensor->sequenceCheck.direction;
+    pFlyingStart->refDirectionCmd = pMCData->directionCmd;
+    pFlyingStart->valid = (pFlyingStart->refDuty != 0) &&
+                (pFlyingStart->refSpeed != 0) && 
+                (pMotorInputs->measureVdc.value > 0) &&
+                (pMotorInputs->bemfZeroCross.active == false);
+}
+
+/**
+* <B> Function: bool MCAPP_FlyingStartDuty (MC1APP_DATA_T *, uint16_t *)  </B>
+*
+* @brief Function to check whether the coasting rotor can be caught and to 
+*        compute the duty cycle matching its BEMF. The rotor must turn in 
+*        the commanded direction, as when it was stopped, with Hall edges 
+*        in sequence. BEMF is proportional to speed, so the duty cycle of the
+*        last operating point is scaled by the ratio of speeds and of DC bus
+*        voltages.
+*
+* @param Pointer to the data structure containing Application parameters.
+* @param Pointer to the duty cycle (unit : PWM timer counts).
+* @return true if the motor can be restarted on the fly.
+* 
+* @example
+* <CODE> MCAPP_FlyingStartDuty(&pMCData, &duty); </CODE>
+*
+*/
+static bool MCAPP_FlyingStartDuty(MC1APP_DATA_T *pMCData, uint16_t *pDuty)
+{
+    MCAPP_FLYING_START_T *pFlyingStart = &pMCData->flyingStart;
+    MCAPP_MEASURE_T *pMotorInputs = pMCData->pMotorInputs;
+    MCAPP_HALL_SENSOR_T *pHallSensor = &pMotorInputs->detectRotorPosition;
+    int16_t vdc = pMotorInputs->measureVdc.value;
+    uint32_t product;
+    uint16_t duty;
+    
+    if((pFlyingStart->valid == false) ||
+            (pHallSensor->motorStopCounter == 0) ||
+            (pHallSensor->edgeCount < FLYING_START_MIN_EDGES) ||
+            (pHallSensor->sequenceCheck.errorLevel != 0) ||
+            (pHallSensor->sequenceCheck.direction != 
+                                            pFlyingStart->refDirection) ||
+            (pMCData->directionCmd != pFlyingStart->refDirectionCmd) ||
+            (vdc <= 0))
+    {
+        return false;
+    }
+    
+    product = MCAPP_MulUU(pFlyingStart->refDuty, 
+                                        pHallSensor->calculateSpeed.speed);
+    if((product >> 16) >= pFlyingStart->refSpeed)
+    {
+        duty = UINT16_MAX;
+    }
+    else
+    {
+        duty = MCAPP_DivUD(product, pFlyingStart->refSpeed);
+    }
+    
+    product = MCAPP_MulUU(duty, pFlyingStart->refVdc);
+    if((product >> 16) >= (uint16_t)vdc)
+    {
+        duty = UINT16_MAX;
+    }
+    else
+    {
+        duty = MCAPP_DivUD(product, (uint16_t)vdc);
+    }
+    
+    *pDuty = duty;
+    return true;
+}
+#endif
+
 /**
 * <B> Function: void MCAPP_MC1ReceivedDataProcess (MC1APP_DATA_T *)  </B>
 *
@@ -62,6 +62,7 @@ extern "C" {
 // <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS ">
 
 void MCAPP_MC1ServiceInit(void);
+void MCAPP_MC1ServiceStepMain(void);
 void MCAPP_MC1InputBufferSet(uint16_t, uint16_t);
 
 // </editor-fold>
@@ -67,7 +67,9 @@ extern "C" {
 /*Control Loop Selection : 
                         0 = Open-loop duty control
                         1 = Closed-loop speed control using a PI controller
-                        2 = Closed-loop current control using a PI controller */
+                        2 = Closed-loop current control using a PI controller
+                        3 = Closed-loop speed control with inner current 
+                            control, speed PI output is the current reference */
 #define CLOSED_LOOP 1
     
 /* Define INTERNAL_OPAMP_CONFIG to use internal op-amp outputs(default), 
@@ -75,6 +77,60 @@ extern "C" {
    development board;Ensure the jumper resistors are modified on DIM  */
 #define INTERNAL_OPAMP_CONFIG
 
+/* Define ENABLE_PHASE_ADVANCE to commutate ahead of the Hall edge by the 
+ * speed dependent advance set in the motor header file, 
+ * Undefine ENABLE_PHASE_ADVANCE to commutate on the Hall edge (default) */
+#undef ENABLE_PHASE_ADVANCE
+
+/* Define ENABLE_HALLSEQ_TABLE_STORE to save the result of the hall sequence
+ * identifier in flash and skip identification at the next start up, 
+ * Undefine ENABLE_HALLSEQ_TABLE_STORE to identify the hall sequence at every 
+ * start up (default).
+ * The saved record is only checked against the motor selection and pole 
+ * pairs : after rewiring the Hall sensors or the motor phases, reprogram the
+ * device to erase the record and identify again */
+#undef ENABLE_HALLSEQ_TABLE_STORE
+
+/* Define ENABLE_IBUS_OVERSAMPLING to convert the bus current twice per PWM 
+ * cycle (PG1TRIGB and PG1TRIGC) and use the hardware average of the two, 
+ * Undefine ENABLE_IBUS_OVERSAMPLING to convert the bus current once per PWM 
+ * cycle (PG1TRIGB). 
+ * ENABLE_IBUS_OVERSAMPLING also raises the bus current filter coefficient 
+ * (IBUS_FILTER_COEFF), which sets the response of the identifier current 
+ * limit as well : check the identifier current limiting before enabling */
+#undef ENABLE_IBUS_OVERSAMPLING
+
+/* Define ENABLE_CN_COMMUTATION to apply the commutation pattern of a new Hall
+ * value in the Hall change notification interrupt, 
+ * Undefine ENABLE_CN_COMMUTATION to commutate in the next control interrupt 
+ * only (up to one PWM period after the Hall edge). Duty cycle is always 
+ * controlled in the control interrupt (default) */
+#undef ENABLE_CN_COMMUTATION
+
+/* Define ENABLE_HALL_GLITCH_FILTER to reject Hall edges that follow the 
+ * previous edge too closely or do not move to an adjacent sector of the 
+ * identified sequence (noise coupled into the Hall inputs), 
+ * Undefine ENABLE_HALL_GLITCH_FILTER to accept every Hall edge (default) */
+#undef ENABLE_HALL_GLITCH_FILTER
+/* Shortest Hall period accepted by the glitch filter (unit : microseconds) */
+#define HALL_GLITCH_MIN_PERIOD_USEC         20
+
+/* Define ENABLE_BEMF_FALLBACK to commutate on the BEMF zero crossings of the
+ * floating phase when the Hall sensors fail while the motor runs, until the
+ * motor is stopped, 
+ * Undefine ENABLE_BEMF_FALLBACK to stop the motor on a Hall sensor fault 
+ * (default). Phase and DC bus voltage measurements must have the same 
+ * divider scaling */
+#undef ENABLE_BEMF_FALLBACK
+
+/* Define ENABLE_FLYING_START to restart a motor that is still coasting 
+ * without waiting for standstill : the duty cycle is preset to match the BEMF
+ * estimated from the Hall speed, bootstrap charging and current offset 
+ * measurement are skipped, 
+ * Undefine ENABLE_FLYING_START to always restart as from standstill 
+ * (default) */
+#undef ENABLE_FLYING_START
+
 /*Motor Selection : 1 = Hurst DMA0204024B101(AC300022: Hurst300 or Long Hurst)
                     2 = Hurst DMB0224C10002(AC300020: Hurst075 or Short Hurst)
                     3 = ACT 24V 3-Phase Brushless DC Motor - ACT 57BLF02
@@ -83,12 +83,32 @@ extern "C" {
 #define SPEEDCNTR_OUTMAX                              Q15(0.999)
 #define SPEEDCNTR_OUTMIN                              Q15(0.0)
 
+/* Speed Control Loop with inner Current Control (CLOSED_LOOP 3) - PI 
+   Coefficients, output is the current reference in Q15 of rated current. 
+   ITERM is the integral gain per control period : it is multiplied by the 
+   number of control periods between two executions of the speed loop */
+#define SPDCURCNTR_PTERM                              3750
+#define SPDCURCNTR_ITERM                              10
+#define SPDCURCNTR_CTERM                              Q15(0.999)
+#define SPDCURCNTR_OUTMAX                             Q15(0.999)
+#define SPDCURCNTR_OUTMIN                             Q15(0.0)
+
 /* Current Control Loop - PI Coefficients */
 #define CURRCNTR_PTERM                               25000
 #define CURRCNTR_ITERM                               90
 #define CURRCNTR_CTERM                               Q15(0.999)
 #define CURRCNTR_OUTMAX                              Q15(0.999)
     
+/*Commutation phase advance (used when ENABLE_PHASE_ADVANCE is defined) :
+  advance rises linearly from 0 at PHASE_ADVANCE_START_RPM to 
+  PHASE_ADVANCE_MAX_DEG at MAXIMUM_SPEED_RPM; must be less than 30 degrees.
+  No advance by default : set the curve from measurements on the motor 
+  (e.g. phase current aligned with BEMF at rated load) before enabling it */
+/* Speed at which phase advance starts (unit : RPM) */
+#define PHASE_ADVANCE_START_RPM                       1500.0f
+/* Phase advance at maximum speed (unit : electrical degrees) */
+#define PHASE_ADVANCE_MAX_DEG                         0.0f
+    
 /*Fault parameters*/ 
 /* Overcurrent fault limit(comparator and Fault PCI) - bus current (unit : amps)*/
 #define OC_FAULT_LIMIT_DCBUS                            7.0f  
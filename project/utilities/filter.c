@@ -47,60 +47,95 @@
 // <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
 
 #include <stdint.h>
+#include "general.h"
 #include "filter.h"
 
 // </editor-fold>
 
-// <editor-fold defaultstate="expanded" desc="VARIABLES ">
-
-MCAPP_FILTER_LPF_T lowPassFilter;
-MCAPP_FILTER_AVG_T movingAvgFilter;
-
-// </editor-fold>
-
 // <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS ">
 
 /**
-* <B> Function: MCAPP_LowPassFilter((input) </B>
+* <B> Function: MCAPP_LowPassFilter(&pFilter, input) </B>
 *
 * @brief Function to implement low pass filter. 
 *        
 * @param Pointer to the data structure containing variables for LPF.
+* @param Filter input.
 * @return filtered output.
 * 
 * @example
-* <CODE> MCAPP_LowPassFilter(input); </CODE>
+* <CODE> MCAPP_LowPassFilter(&pFilter, input); </CODE>
 *
 */
-int16_t MCAPP_LowPassFilter (int16_t input)
+int16_t MCAPP_LowPassFilter (MCAPP_FILTER_LPF_T *pFilter, int16_t input)
 {
     /* Filter input using a first order low-pass filter */
-    const int16_t delta = (int16_t) (input - lowPassFilter.qFilterOutput);
-    lowPassFilter.accumalator += __builtin_mulss(delta, LFP_CUTOFF_FREQUENCY);
-    lowPassFilter.qFilterOutput = (int16_t) (lowPassFilter.accumalator >> 15);
+    const int16_t delta = (int16_t) (input - pFilter->qFilterOutput);
+    pFilter->accumalator += MCAPP_MulSS(delta, pFilter->coefficient);
+    pFilter->qFilterOutput = (int16_t) (pFilter->accumalator >> 15);
+    
+    return pFilter->qFilterOutput;
+}
+
+/**
+* <B> Function: MCAPP_RingAvgFilterInit(&pFilter) </B>
+*
+* @brief Function to clear the ring buffer moving average filter. 
+*        
+* @param Pointer to the data structure containing variables for filter.
+* @return none.
+* 
+* @example
+* <CODE> MCAPP_RingAvgFilterInit(&pFilter); </CODE>
+*
+*/
+void MCAPP_RingAvgFilterInit (MCAPP_FILTER_RING_AVG_T *pFilter)
+{
+    uint16_t i;
     
-    return lowPassFilter.qFilterOutput;
+    for(i = 0; i < RINGAVG_FILTER_LENGTH; i++)
+    {
+        pFilter->buffer[i] = 0;
+    }
+    pFilter->index = 0;
+    pFilter->count = 0;
+    pFilter->average = 0;
+    pFilter->sum = 0;
 }
 
 /**
-* <B> Function: MCAPP_MovingAvgFilter(input) </B>
+* <B> Function: MCAPP_RingAvgFilter(&pFilter, input) </B>
 *
-* @brief Function to implement moving average filter. 
+* @brief Function to implement moving average over the last 
+*        RINGAVG_FILTER_LENGTH inputs. Until the buffer is filled, the average
+*        is computed over the inputs received so far.
 *        
 * @param Pointer to the data structure containing variables for filter.
+* @param Filter input.
 * @return average filter output.
 * 
 * @example
-* <CODE> MCAPP_MovingAvgFilter(input); </CODE>
+* <CODE> MCAPP_RingAvgFilter(&pFilter, input); </CODE>
 *
 */
-int16_t MCAPP_MovingAvgFilter (int16_t input)
+uint16_t MCAPP_RingAvgFilter (MCAPP_FILTER_RING_AVG_T *pFilter, uint16_t input)
 {
-    movingAvgFilter.accumalator += input;
-    movingAvgFilter.mean = (int16_t) (movingAvgFilter.accumalator >> AVGFILTER_SCALER);
-    movingAvgFilter.accumalator -= movingAvgFilter.mean;
-    movingAvgFilter.average = movingAvgFilter.mean;
+    /* Replace the oldest input with the new one */
+    pFilter->sum = pFilter->sum - pFilter->buffer[pFilter->index] + input;
+    pFilter->buffer[pFilter->index] = input;
+    
+    pFilter->index++;
+    if(pFilter->index >= RINGAVG_FILTER_LENGTH)
+    {
+        pFilter->index = 0;
+    }
+    if(pFilter->count < RINGAVG_FILTER_LENGTH)
+    {
+        pFilter->count++;
+    }
+    
+    pFilter->average = MCAPP_DivUD(pFilter->sum, pFilter->count);
     
-    return movingAvgFilter.average;
+    return pFilter->average;
 }
 // </editor-fold> 
\ No newline at end of file
@@ -59,15 +59,15 @@ extern "C" {
 #include "filter_types.h"
 // </editor-fold>
 // <editor-fold defaultstate="expanded" desc="DEFINITIONS/CONSTANTS ">
-/* Cut-off frequency for Low pass filter */    
+/* Default cut-off frequency for Low pass filter */    
 #define LFP_CUTOFF_FREQUENCY 500
-#define AVGFILTER_SCALER  8
 // </editor-fold> 
     
 // <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS ">
 
-int16_t MCAPP_LowPassFilter (int16_t);
-int16_t MCAPP_MovingAvgFilter (int16_t);
+int16_t MCAPP_LowPassFilter (MCAPP_FILTER_LPF_T *, int16_t);
+void MCAPP_RingAvgFilterInit (MCAPP_FILTER_RING_AVG_T *);
+uint16_t MCAPP_RingAvgFilter (MCAPP_FILTER_RING_AVG_T *, uint16_t);
 
 // </editor-fold> 
 
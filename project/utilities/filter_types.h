@@ -51,6 +51,18 @@
 extern "C" {
 #endif
 
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+
+#include <stdint.h>
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="DEFINITIONS/CONSTANTS ">
+
+/* Length of ring buffer moving average filter: Multiple of 6 so that the
+ * average covers complete electrical revolutions of Hall periods */
+#define RINGAVG_FILTER_LENGTH   (6 * 2)
+// </editor-fold>
+
 // <editor-fold defaultstate="collapsed" desc="TYPE DEFINITIONS ">
     
 /**
@@ -59,18 +71,21 @@ extern "C" {
 typedef struct
 {
     int16_t qFilterOutput; /* Output of LPF */
+    int16_t coefficient;   /* Filter coefficient, LFP_CUTOFF_FREQUENCY */
     int32_t accumalator;   /*Variable to accumulate previous output */
 }MCAPP_FILTER_LPF_T;
 
 /**
- * Moving average filter data type
+ * Ring buffer moving average filter data type
 */
 typedef struct
 {
-    int16_t mean;           /* mean value */
-    int16_t average;        /* average filtered data */
-    int32_t accumalator;    /*Variable to accumulate previous output */
-}MCAPP_FILTER_AVG_T;
+    uint16_t buffer[RINGAVG_FILTER_LENGTH]; /* Last RINGAVG_FILTER_LENGTH inputs */
+    uint16_t index;         /* Position of the oldest input in buffer */
+    uint16_t count;         /* Number of valid inputs in buffer */
+    uint16_t average;       /* average filtered data */
+    uint32_t sum;           /* Sum of the inputs in buffer */
+}MCAPP_FILTER_RING_AVG_T;
   
 // </editor-fold>
 #ifdef	__cplusplus
@@ -0,0 +1,85 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * @file scheduler.c
+ *
+ * @brief This module sets the rate of tasks executed in the control 
+ * interrupt.
+ *
+ * Component: SCHEDULER
+ *
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "scheduler.h"
+
+// </editor-fold>
+
+// <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS ">
+
+/**
+* <B> Function: MCAPP_SchedulerTaskInit(&pTask, divisor, phase) </B>
+*
+* @brief Function to set the rate of a task. The task runs in the calls 
+*        phase, phase + divisor, phase + 2 x divisor ... of 
+*        MCAPP_SchedulerTaskDue.
+*        
+* @param Pointer to the data structure containing task rate.
+* @param Divisor of the interrupt rate (1 = every interrupt).
+* @param Phase, 0 to divisor - 1.
+* @return none.
+* 
+* @example
+* <CODE> MCAPP_SchedulerTaskInit(&pTask, 10, 5); </CODE>
+*
+*/
+void MCAPP_SchedulerTaskInit(MCAPP_SCHEDULER_TASK_T *pTask, uint16_t divisor,
+                                uint16_t phase)
+{
+    if(divisor == 0)
+    {
+        divisor = 1;
+    }
+    pTask->divisor = divisor;
+    pTask->phase = phase % divisor;
+    pTask->count = pTask->phase;
+}
+// </editor-fold>
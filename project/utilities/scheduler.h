@@ -0,0 +1,99 @@
+// <editor-fold defaultstate="collapsed" desc="Description/Instruction ">
+/**
+ * @file scheduler.h
+ *
+ * @brief This header file lists definitions and interface functions 
+ * to run tasks of the control interrupt at a fraction of its rate.
+ * 
+ * Tasks with the same divisor are given different phases so that they run
+ * in different interrupts.
+ * 
+ * Component: SCHEDULER 
+ * 
+ */
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Disclaimer ">
+
+/*******************************************************************************
+* SOFTWARE LICENSE AGREEMENT
+* 
+*  [2024] Microchip Technology Inc. and its subsidiaries
+* 
+* Subject to your compliance with these terms, you may use this Microchip 
+* software and any derivatives exclusively with Microchip products. 
+* You are responsible for complying with third party license terms applicable to
+* your use of third party software (including open source software) that may 
+* accompany this Microchip software.
+* 
+* Redistribution of this Microchip software in source or binary form is allowed 
+* and must include the above terms of use and the following disclaimer with the
+* distribution and accompanying materials.
+* 
+* SOFTWARE IS "AS IS." NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY,
+* APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED WARRANTIES OF NON-INFRINGEMENT,
+* MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT WILL 
+* MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, INCIDENTAL OR 
+* CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND WHATSOEVER RELATED TO
+* THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS BEEN ADVISED OF THE 
+* POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY
+* LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS RELATED TO THE SOFTWARE WILL
+* NOT EXCEED AMOUNT OF FEES, IF ANY, YOU PAID DIRECTLY TO MICROCHIP FOR THIS
+* SOFTWARE
+*
+* You agree that you are solely responsible for testing the code and
+* determining its suitability.  Microchip has no obligation to modify, test,
+* certify, or support the code.
+*
+*******************************************************************************/
+// </editor-fold>
+
+#ifndef SCHEDULER_H
+#define	SCHEDULER_H
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+// <editor-fold defaultstate="collapsed" desc="HEADER FILES ">
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "scheduler_types.h"
+// </editor-fold>
+    
+// <editor-fold defaultstate="expanded" desc="INTERFACE FUNCTIONS ">
+
+void MCAPP_SchedulerTaskInit (MCAPP_SCHEDULER_TASK_T *, uint16_t, uint16_t);
+
+/**
+* <B> Function: MCAPP_SchedulerTaskDue(&pTask) </B>
+*
+* @brief Function to check whether the task runs in this call. To be called
+*        once per interrupt.
+*        
+* @param Pointer to the data structure containing task rate.
+* @return true if the task runs.
+* 
+* @example
+* <CODE> MCAPP_SchedulerTaskDue(&pTask); </CODE>
+*
+*/
+inline static bool MCAPP_SchedulerTaskDue(MCAPP_SCHEDULER_TASK_T *pTask)
+{
+    if(pTask->count == 0)
+    {
+        pTask->count = pTask->divisor - 1;
+        return true;
+    }
+    pTask->count--;
+    return false;
+}
+
+// </editor-fold> 
+
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* SCHEDULER_H */